@@ -0,0 +1,50 @@
+#include "CD_Driver.H"
+#include <CD_CdrGodunov.H>
+#include <CD_RodDielectric.H>
+#include <CD_AdvectionDiffusionStepper.H>
+#include <CD_AdvectionDiffusionTagger.H>
+#include <CD_Benchmark.H>
+#include "ParmParse.H"
+
+using namespace ChomboDischarge;
+using namespace Physics::AdvectionDiffusion;
+
+int
+main(int argc, char* argv[])
+{
+
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+#endif
+
+  // Build class options from input script and command line options
+  const std::string input_file = argv[1];
+  ParmParse         pp(argc - 2, argv + 2, NULL, input_file.c_str());
+
+  // Set geometry and AMR
+  RefCountedPtr<ComputationalGeometry> compgeom   = RefCountedPtr<ComputationalGeometry>(new RodDielectric());
+  RefCountedPtr<AmrMesh>               amr        = RefCountedPtr<AmrMesh>(new AmrMesh());
+  RefCountedPtr<GeoCoarsener>          geocoarsen = RefCountedPtr<GeoCoarsener>(new GeoCoarsener());
+
+  // Set up basic AdvectionDiffusion
+  auto solver      = RefCountedPtr<CdrSolver>(new CdrGodunov());
+  auto timestepper = RefCountedPtr<AdvectionDiffusionStepper>(new AdvectionDiffusionStepper(solver));
+  auto tagger      = RefCountedPtr<CellTagger>(new AdvectionDiffusionTagger(solver, amr));
+
+  // Set up the Driver
+  auto engine = RefCountedPtr<BenchmarkDriver>(new BenchmarkDriver(compgeom, timestepper, amr, tagger, geocoarsen));
+  engine->setupBenchmark(input_file);
+
+  // Time full advection-diffusion steps. Regridding is turned off so the grids are the same for every step.
+  BenchmarkReport report("CdrSolver");
+
+  report.timeSection("advance", engine->getNumCells(), "cells", [&]() { engine->advanceBenchmark(); });
+
+  report.writeReport();
+
+#ifdef CH_MPI
+  CH_TIMER_REPORT();
+  MPI_Finalize();
+#endif
+}
@@ -0,0 +1,61 @@
+#include "CD_Driver.H"
+#include "CD_FieldSolverMultigrid.H"
+#include <CD_RodDielectric.H>
+#include "CD_FieldStepper.H"
+#include <CD_Benchmark.H>
+#include "ParmParse.H"
+
+using namespace ChomboDischarge;
+using namespace Physics::Electrostatics;
+
+// Field stepper which exposes the field solver.
+class BenchmarkStepper : public FieldStepper<FieldSolverMultigrid>
+{
+public:
+  RefCountedPtr<FieldSolver>&
+  getFieldSolver()
+  {
+    return m_fieldSolver;
+  }
+};
+
+int
+main(int argc, char* argv[])
+{
+
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+#endif
+
+  // Build class options from input script and command line options
+  const std::string input_file = argv[1];
+  ParmParse         pp(argc - 2, argv + 2, NULL, input_file.c_str());
+
+  // Set geometry and AMR
+  RefCountedPtr<ComputationalGeometry> compgeom   = RefCountedPtr<ComputationalGeometry>(new RodDielectric());
+  RefCountedPtr<AmrMesh>               amr        = RefCountedPtr<AmrMesh>(new AmrMesh());
+  RefCountedPtr<GeoCoarsener>          geocoarsen = RefCountedPtr<GeoCoarsener>(new GeoCoarsener());
+  RefCountedPtr<CellTagger>            tagger     = RefCountedPtr<CellTagger>(NULL);
+
+  // Set up basic Poisson, potential = 1
+  auto timestepper = RefCountedPtr<BenchmarkStepper>(new BenchmarkStepper());
+
+  // Set up the Driver
+  auto engine = RefCountedPtr<BenchmarkDriver>(new BenchmarkDriver(compgeom, timestepper, amr, tagger, geocoarsen));
+  engine->setupBenchmark(input_file);
+
+  // Time the multigrid solve. Every solve starts from a zero potential so that repetitions do the same work.
+  BenchmarkReport report("FieldSolverMultigrid");
+
+  RefCountedPtr<FieldSolver>& solver = timestepper->getFieldSolver();
+
+  report.timeSection("solve", engine->getNumCells(), "cells", [&]() { solver->solve(true); });
+
+  report.writeReport();
+
+#ifdef CH_MPI
+  CH_TIMER_REPORT();
+  MPI_Finalize();
+#endif
+}
@@ -0,0 +1,54 @@
+#include "CD_Driver.H"
+#include <CD_RodDielectric.H>
+#include <CD_GeometryStepper.H>
+#include <CD_Benchmark.H>
+#include "ParmParse.H"
+
+using namespace ChomboDischarge;
+using namespace Physics::Geometry;
+
+int
+main(int argc, char* argv[])
+{
+
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+#endif
+
+  // Build class options from input script and command line options
+  const std::string input_file = argv[1];
+  ParmParse         pp(argc - 2, argv + 2, NULL, input_file.c_str());
+
+  // Set geometry and AMR
+  RefCountedPtr<ComputationalGeometry> compgeom   = RefCountedPtr<ComputationalGeometry>(new RodDielectric());
+  RefCountedPtr<GeoCoarsener>          geocoarsen = RefCountedPtr<GeoCoarsener>(new GeoCoarsener());
+  RefCountedPtr<CellTagger>            tagger     = RefCountedPtr<CellTagger>(NULL);
+
+  // Time the geometry generation. Every repetition sets up a new driver with Driver.geometry_only = true, which builds
+  // the EB index spaces and the grids from the geometric tags.
+  BenchmarkReport report("ScanShop");
+
+  RefCountedPtr<AmrMesh>         amr;
+  RefCountedPtr<BenchmarkDriver> engine;
+
+  const auto setupGeometry = [&]() {
+    amr    = RefCountedPtr<AmrMesh>(new AmrMesh());
+    engine = RefCountedPtr<BenchmarkDriver>(
+      new BenchmarkDriver(compgeom, RefCountedPtr<GeometryStepper>(new GeometryStepper()), amr, tagger, geocoarsen));
+
+    engine->setupBenchmark(input_file);
+  };
+
+  // The number of cells on the finest domain is only known after the first setup.
+  setupGeometry();
+
+  report.timeSection("geometry", engine->getNumFinestDomainCells(), "cells", setupGeometry);
+
+  report.writeReport();
+
+#ifdef CH_MPI
+  CH_TIMER_REPORT();
+  MPI_Finalize();
+#endif
+}
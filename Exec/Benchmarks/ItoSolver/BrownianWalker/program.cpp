@@ -0,0 +1,78 @@
+#include "CD_Driver.H"
+#include <CD_ItoSolver.H>
+#include <CD_RodDielectric.H>
+#include <CD_BrownianWalkerStepper.H>
+#include <CD_BrownianWalkerTagger.H>
+#include <CD_Benchmark.H>
+#include "ParmParse.H"
+
+using namespace ChomboDischarge;
+using namespace Physics::BrownianWalker;
+
+int
+main(int argc, char* argv[])
+{
+
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+#endif
+
+  // Build class options from input script and command line options
+  const std::string input_file = argv[1];
+  ParmParse         pp(argc - 2, argv + 2, NULL, input_file.c_str());
+
+  // Set geometry and AMR
+  RefCountedPtr<ComputationalGeometry> compgeom   = RefCountedPtr<ComputationalGeometry>(new RodDielectric());
+  RefCountedPtr<AmrMesh>               amr        = RefCountedPtr<AmrMesh>(new AmrMesh());
+  RefCountedPtr<GeoCoarsener>          geocoarsen = RefCountedPtr<GeoCoarsener>(new GeoCoarsener());
+
+  // Set up basic BrownianWalker
+  RefCountedPtr<ItoSolver>   solver      = RefCountedPtr<ItoSolver>(new ItoSolver());
+  RefCountedPtr<TimeStepper> timestepper = RefCountedPtr<TimeStepper>(new BrownianWalkerStepper(solver));
+  RefCountedPtr<CellTagger>  tagger      = RefCountedPtr<CellTagger>(new BrownianWalkerTagger(solver, amr));
+
+  // Set up the Driver
+  auto engine = RefCountedPtr<BenchmarkDriver>(new BenchmarkDriver(compgeom, timestepper, amr, tagger, geocoarsen));
+  engine->setupBenchmark(input_file);
+
+  // Target number of particles per cell when benchmarking particle merging.
+  int mergePPC = 4;
+
+  ParmParse ppBenchmark("Benchmark");
+  ppBenchmark.query("merge_ppc", mergePPC);
+
+  BenchmarkReport report("ItoSolver");
+
+  const auto bulk         = ItoSolver::WhichContainer::Bulk;
+  const auto numParticles = [&]() -> long long { return solver->getNumParticles(bulk, false); };
+
+  // Deposition and remapping of the initial particles. Since the particles do not move, remap() only measures the cost
+  // of checking which particles need to be moved.
+  report.timeSection("deposit", numParticles(), "particles", [&]() { solver->depositParticles(); });
+  report.timeSection("remap", numParticles(), "particles", [&]() { solver->remap(); });
+
+  // Merging destroys the particles, so regenerate them before every merge.
+  solver->initialData();
+  const long long numMergeParticles = numParticles();
+
+  report.timeSection(
+    "merge",
+    numMergeParticles,
+    "particles",
+    [&]() { solver->makeSuperparticles(bulk, mergePPC); },
+    [&]() { solver->initialData(); });
+
+  // Full time steps (move, remap, deposit, and so on). The particles are regenerated first so that this does not run on
+  // merged particles.
+  solver->initialData();
+
+  report.timeSection("advance", numParticles(), "particles", [&]() { engine->advanceBenchmark(); });
+
+  report.writeReport();
+
+#ifdef CH_MPI
+  CH_TIMER_REPORT();
+  MPI_Finalize();
+#endif
+}
@@ -0,0 +1,63 @@
+#include "CD_Driver.H"
+#include <CD_McPhoto.H>
+#include <CD_RodDielectric.H>
+#include <CD_RadiativeTransferStepper.H>
+#include <CD_Benchmark.H>
+#include "ParmParse.H"
+
+using namespace ChomboDischarge;
+using namespace Physics::RadiativeTransfer;
+
+// Radiative transfer stepper which exposes the solver.
+class BenchmarkStepper : public RadiativeTransferStepper<McPhoto>
+{
+public:
+  RefCountedPtr<RtSolver>&
+  getSolver()
+  {
+    return m_solver;
+  }
+};
+
+int
+main(int argc, char* argv[])
+{
+
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+#endif
+
+  // Build class options from input script and command line options
+  const std::string input_file = argv[1];
+  ParmParse         pp(argc - 2, argv + 2, NULL, input_file.c_str());
+
+  // Set geometry and AMR
+  RefCountedPtr<ComputationalGeometry> compgeom   = RefCountedPtr<ComputationalGeometry>(new RodDielectric());
+  RefCountedPtr<AmrMesh>               amr        = RefCountedPtr<AmrMesh>(new AmrMesh());
+  RefCountedPtr<GeoCoarsener>          geocoarsen = RefCountedPtr<GeoCoarsener>(new GeoCoarsener());
+  RefCountedPtr<CellTagger>            tagger     = RefCountedPtr<CellTagger>(NULL);
+
+  // Set up the radiative transfer stepper
+  auto timestepper = RefCountedPtr<BenchmarkStepper>(new BenchmarkStepper());
+
+  // Set up the Driver
+  auto engine = RefCountedPtr<BenchmarkDriver>(new BenchmarkDriver(compgeom, timestepper, amr, tagger, geocoarsen));
+  engine->setupBenchmark(input_file);
+
+  // Time the photon transport, i.e. generation, transport, and deposition of photons.
+  BenchmarkReport report("McPhoto");
+
+  RefCountedPtr<RtSolver>& solver = timestepper->getSolver();
+
+  const Real dt = timestepper->computeDt();
+
+  report.timeSection("advance", engine->getNumCells(), "cells", [&]() { solver->advance(dt); });
+
+  report.writeReport();
+
+#ifdef CH_MPI
+  CH_TIMER_REPORT();
+  MPI_Finalize();
+#endif
+}
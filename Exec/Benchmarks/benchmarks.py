@@ -0,0 +1,296 @@
+import os
+import glob
+import argparse
+import sys
+import configparser
+import subprocess
+import json
+import time
+from subprocess import DEVNULL
+
+# This script requires Python3.5 to work properly
+MIN_PYTHON = (3,5)
+if sys.version_info < MIN_PYTHON:
+    sys.exit("Python %s.%s or later is required.\n" % MIN_PYTHON)
+
+# --------------------------------------------------
+# Set up arguments that can be passed into this
+# script
+# --------------------------------------------------
+parser = argparse.ArgumentParser()
+
+parser.add_argument('--compile',              help="Compile executables.",                        action='store_true')
+parser.add_argument('--silent',               help="Turn off unnecessary output.",                action='store_true')
+parser.add_argument('--clean',                help="Do a clean compile.",                         action='store_true')
+parser.add_argument('--save_baseline',        help="Store the results as the new baseline.",      action='store_true')
+parser.add_argument('--no_exec',              help="Do not run executables.",                     action='store_true')
+parser.add_argument('--no_compare',           help="Do not compare with the baseline.",           action='store_true')
+parser.add_argument('--parallel',             help="Run in parallel or not",                      action='store_true')
+parser.add_argument('-exec_mpi',              help="MPI run command.", type=str, default="mpirun")
+parser.add_argument('-cores',                 help="Number of cores to use", type=int, default=2)
+parser.add_argument('-suites',                help="Benchmark suite (e.g. 'FieldSolver' or 'Regrid')", nargs='+', default="all")
+parser.add_argument('-benchmarks',            help="Individual benchmarks in benchmark suite.", nargs='+', required=False)
+parser.add_argument('-dim',                   help="Benchmark dimensionality", type=int, default=-1, required=False)
+parser.add_argument('-repetitions',           help="Override the number of timed repetitions", type=int, default=-1)
+parser.add_argument('-results',               help="JSON file with the results", type=str, default="results.json")
+parser.add_argument('-baseline',              help="JSON file with the baseline", type=str, default="baseline.json")
+parser.add_argument('-tolerance',             help="Relative slowdown that is flagged", type=float, default=0.1)
+parser.add_argument('-memory_tolerance',      help="Relative increase in peak memory that is flagged", type=float, default=0.1)
+
+args = parser.parse_args()
+
+# --------------
+# Base directory.
+# --------------
+baseDir = os.getcwd()
+
+# ---------
+# Exit code
+# ---------
+ret_code = 0
+
+# -------------------------------------------------------------
+# Set up benchmark suite. If 'suite' is all, do all bench files
+# -------------------------------------------------------------
+bench_files = []
+if args.suites == "all":
+    for file in glob.glob("*.ini"):
+        bench_files.append(file)
+else:
+    for s in args.suites:
+        file = str(s) + ".ini"
+        bench_files.append(file)
+
+# --------------------------------
+# Print which suites we're running
+# --------------------------------
+print("Running benchmark suites: " + str(bench_files))
+
+# ---------------
+# Parse ini files
+# ---------------
+config = configparser.ConfigParser()
+config.read(bench_files)
+
+# --------------------------------------------------
+# Moron check for running the benchmark suite
+# --------------------------------------------------
+def pre_check(silent):
+    """ Check that chombo-discharge has been appropriately set up with an environment variable.
+        Print some error messages and what to do if we can't run anything. """
+    print("Running " + __file__ + "...")
+    discharge_home = os.environ.get("DISCHARGE_HOME")
+    if not discharge_home:
+        print("Error: Cannot run benchmarks because the DISCHARGE_HOME environment variable has not been set.")
+        print("Please set DISCHARGE_HOME, for example: '> export  DISCHARGE_HOME=<directory>'")
+        print("Aborting benchmark suite")
+        exit()
+
+    print("CWD            = " + os.getcwd())
+    print("DISCHARGE_HOME = " + discharge_home)
+
+# --------------------------------------------------
+# Function that compiles a benchmark
+# --------------------------------------------------
+def compile_benchmark(silent, build_procs, dim, clean, main):
+    """ Set up and run a compilation of the target benchmark. """
+
+    makeCommand = "make "
+    if silent:
+        makeCommand += "-s "
+    makeCommand += "-j" + str(build_procs) + " "
+    makeCommand += "DIM=" + str(dim) + " "
+    if clean:
+        makeCommand += "clean "
+    makeCommand += str(main)
+
+    print("\t Compiling with   = '" + str(makeCommand) + "'")
+
+    if silent:
+        exit_code = subprocess.call(makeCommand, shell=True, stdout=DEVNULL, stderr=DEVNULL)
+    else:
+        exit_code = subprocess.call(makeCommand, shell=True)
+    return exit_code
+
+# --------------------------------------------------
+# Function that compares a benchmark with the baseline
+# --------------------------------------------------
+def compare_benchmark(name, result, baseline):
+    """ Compare the sections in a benchmark with the baseline. Returns the number of sections that got slower or
+        used more memory than allowed by the tolerances. """
+
+    if result["ranks"] != baseline["ranks"]:
+        print("\t Baseline for '" + name + "' was run with a different number of ranks. Skipping comparison.")
+        return 0
+
+    num_flagged = 0
+    for section, res in result["sections"].items():
+        if section not in baseline["sections"]:
+            print("\t Section '" + section + "' not found in baseline")
+            continue
+
+        base = baseline["sections"][section]
+
+        # Compare the best times, they are the least noisy.
+        time_ratio = res["min_time"] / base["min_time"] if base["min_time"] > 0.0 else 1.0
+        mem_ratio  = res["max_peak_memory_mb"] / base["max_peak_memory_mb"] if base["max_peak_memory_mb"] > 0.0 else 1.0
+
+        status = "ok"
+        if time_ratio > 1.0 + args.tolerance:
+            status = "SLOWDOWN"
+        if mem_ratio > 1.0 + args.memory_tolerance:
+            status = "MEMORY INCREASE" if status == "ok" else status + " AND MEMORY INCREASE"
+        if status != "ok":
+            num_flagged += 1
+
+        print(f'\t {section:16} time = {res["min_time"]:.4e}s (baseline {base["min_time"]:.4e}s, x{time_ratio:.3f}), ' +
+              f'peak memory = {res["max_peak_memory_mb"]:.1f}MB (x{mem_ratio:.3f}) -- {status}')
+
+    return num_flagged
+
+# --------------------------------------------------
+# Do a sanity check before trying benchmarks.
+# --------------------------------------------------
+pre_check(args.silent)
+
+# --------------------------------------------------
+# Load the baseline
+# --------------------------------------------------
+baseline = {}
+if not args.save_baseline and not args.no_compare:
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    else:
+        print("Baseline file '" + args.baseline + "' not found, generate it with --save_baseline")
+
+results     = {}
+num_flagged = 0
+
+# --------------------------------------------------
+# Run all benchmarks
+# --------------------------------------------------
+for bench in config.sections():
+
+    # --------------------------------------------------
+    # Check that the configuration parser has the
+    # appropriate keys
+    # --------------------------------------------------
+    do_bench = True
+    for key in ['directory', 'exec', 'input', 'dim']:
+        if not config.has_option(str(bench), key):
+            print("Benchmark [" + str(bench) + "] does not contain option '" + key + "'. Skipping this benchmark")
+            do_bench = False
+
+    if not do_bench:
+        continue
+
+    # --------------------------------------------------
+    # If we're not running all benchmarks, check that the benchmark string equals args.benchmarks
+    # --------------------------------------------------
+    dim = int(config[str(bench)]['dim'])
+    if not args.benchmarks:
+        if dim != args.dim and (args.dim==2 or args.dim==3):
+            do_bench = False
+    else:
+        do_bench = str(bench) in args.benchmarks
+
+    if not do_bench:
+        continue
+
+    directory  = str(config[str(bench)]['directory'])
+    executable = str(config[str(bench)]['exec']) + str(dim) + "d.*.ex"
+    input      = str(config[str(bench)]['input'])
+    output     = "benchmark" + str(dim) + "d.json"
+
+    start = time.time()
+
+    print("\nRunning benchmark '" + str(bench) + "'...")
+    print("\t Directory is     = " + directory)
+    print("\t Input file is    = " + input)
+
+    os.chdir(baseDir + "/" + directory)
+
+    # --------------------------------------------------
+    # Recompile benchmark if user has called for it
+    # --------------------------------------------------
+    run_bench = True
+    if args.compile:
+        compile_code = compile_benchmark(silent=args.silent,
+                                         build_procs=args.cores,
+                                         dim=dim,
+                                         clean=args.clean,
+                                         main=str(config[str(bench)]['exec']))
+        if compile_code != 0:
+            print("\t Compilation of benchmark '" + str(bench) + "' failed. Aborting this benchmark.")
+            run_bench = False
+            ret_code  = 1
+
+    if run_bench and not args.no_exec:
+        if args.parallel:
+            runCommand = args.exec_mpi + " -np " + str(args.cores) + " ./" + executable + " " + input
+        else:
+            runCommand = "./" + executable + " " + input
+
+        runCommand = runCommand + " Benchmark.output=" + output
+        if args.repetitions > 0:
+            runCommand = runCommand + " Benchmark.repetitions=" + str(args.repetitions)
+
+        print("\t Executing with   = '" + str(runCommand) + "'")
+
+        if os.path.exists(output):
+            os.remove(output)
+
+        if args.silent:
+            exit_code = subprocess.call(runCommand, shell=True, stdout=DEVNULL, stderr=DEVNULL)
+        else:
+            exit_code = subprocess.call(runCommand, shell=True)
+
+        if exit_code != 0 or not os.path.exists(output):
+            print("\t Benchmark run failed with exit code = " + str(exit_code))
+            ret_code = 2
+        else:
+            print(f'\t Benchmark completed = {time.time() - start:.2f}s')
+
+            with open(output) as f:
+                results[str(bench)] = json.load(f)
+
+            # --------------------------------------------------
+            # Compare with the baseline.
+            # --------------------------------------------------
+            if str(bench) in baseline:
+                num_flagged += compare_benchmark(str(bench), results[str(bench)], baseline[str(bench)])
+            elif not args.save_baseline and not args.no_compare:
+                print("\t Benchmark '" + str(bench) + "' not found in baseline")
+
+    os.chdir(baseDir)
+
+# --------------------------------------------------
+# Write the aggregated results, and update the baseline
+# if the user asked for it. Benchmarks that were not
+# run keep their old baseline.
+# --------------------------------------------------
+with open(args.results, 'w') as f:
+    json.dump(results, f, indent=2)
+
+print("\nWrote results to '" + args.results + "'")
+
+if args.save_baseline:
+    old_baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            old_baseline = json.load(f)
+
+    old_baseline.update(results)
+
+    with open(args.baseline, 'w') as f:
+        json.dump(old_baseline, f, indent=2)
+
+    print("Wrote baseline to '" + args.baseline + "'")
+
+if num_flagged > 0:
+    print("BENCHMARK REGRESSION: " + str(num_flagged) + " section(s) exceeded the tolerances")
+    if ret_code == 0:
+        ret_code = 3
+
+exit(ret_code)
@@ -22,7 +22,8 @@ main(int argc, char* argv[])
 {
 
 #ifdef CH_MPI
-  MPI_Init(&argc, &argv);
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
 #endif
 
   // Build class options from input script and command line options
@@ -90,8 +90,6 @@ CdrPlasmaFieldTagger::computeTracers() const
     pout() << m_name + "::computeTracers()" << endl;
   }
 
-  constexpr int comp = 0;
-
   // Allocate necessary storage.
   this->allocateStorage();
 
@@ -123,83 +121,32 @@ CdrPlasmaFieldTagger::computeTracers() const
     for (DataIterator dit(dbl); dit.ok(); ++dit) {
       const Box&     box     = dbl.get(dit());
       const EBISBox& ebisbox = ebisl[dit()];
-      const EBGraph& ebgraph = ebisbox.getEBGraph();
 
-      // Expose the AMR data per patch, both full data and the single-valued data.
+      // Expose the AMR data per patch.
       const EBCellFAB& electricField     = (*m_electricField[lvl])[dit()];
       const EBCellFAB& gradElectricField = (*m_gradElectricField[lvl])[dit()];
 
-      const FArrayBox& electricFieldReg     = electricField.getFArrayBox();
-      const FArrayBox& gradElectricFieldReg = gradElectricField.getFArrayBox();
-
-      // Get references to tracer fields, both the full data and the single-valued data. These are needed
-      // in the regular and irregular kernels.
+      // Get references to tracer fields.
       Vector<EBCellFAB*> tr;
-      Vector<FArrayBox*> trReg;
-
       for (int i = 0; i < m_numTracers; i++) {
         tr.push_back(&((*m_tracers[i][lvl])[dit()]));
-        trReg.push_back(&(tr[i]->getFArrayBox()));
       }
 
-      // Regular kernel
-      auto regularKernel = [&](const IntVect& iv) -> void {
-        const RealVect pos = probLo + (0.5 * RealVect::Unit + RealVect(iv)) * dx;
-
-        // Reconstruct the electric field and gradient of the electric field.
-        const RealVect E = RealVect(D_DECL(electricFieldReg(iv, 0), electricFieldReg(iv, 1), electricFieldReg(iv, 2)));
-        const RealVect gradE =
-          RealVect(D_DECL(gradElectricFieldReg(iv, 0), gradElectricFieldReg(iv, 1), gradElectricFieldReg(iv, 2)));
-
-        // Call the per-point tracer function. This is a pure function.
-        const Vector<Real> tracers = this->tracer(pos,
-                                                  time,
-                                                  dx,
-                                                  E,
-                                                  minElectricField,
-                                                  maxElectricField,
-                                                  gradE,
-                                                  minGradElectricField,
-                                                  maxGradElectricField);
-
-        // Put the tracer field where it belongs.
-        for (int i = 0; i < m_numTracers; i++) {
-          (*trReg[i])(iv, comp) = tracers[i];
-        }
-      };
-
-      // Irregular box loop
-      auto irregularKernel = [&](const VolIndex& vof) -> void {
-        const RealVect pos = probLo + Location::position(Location::Cell::Center, vof, ebisbox, dx);
-
-        // Reconstruct the electric field and gradient of the electric field.
-        const RealVect E = RealVect(D_DECL(electricField(vof, 0), electricField(vof, 1), electricField(vof, 2)));
-        const RealVect gradE =
-          RealVect(D_DECL(gradElectricField(vof, 0), gradElectricField(vof, 1), gradElectricField(vof, 2)));
-
-        // Call the per-point tracer function. Again, it's a pure function.
-        const Vector<Real> tracers = this->tracer(pos,
-                                                  time,
-                                                  dx,
-                                                  E,
-                                                  minElectricField,
-                                                  maxElectricField,
-                                                  gradE,
-                                                  minGradElectricField,
-                                                  maxGradElectricField);
-
-        // Put the tracer field where it belongs.
-        for (int i = 0; i < m_numTracers; i++) {
-          (*tr[i])(vof, comp);
-        }
-      };
-
-      // Irregular kernel region
-      VoFIterator vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
-
-      // Execute the kernels
-      BoxLoops::loop(box, regularKernel);
-      BoxLoops::loop(vofit, irregularKernel);
+      // Compute the tracer fields on the patch.
+      this->computeTracersBox(tr,
+                              electricField,
+                              gradElectricField,
+                              lvl,
+                              dit(),
+                              box,
+                              ebisbox,
+                              time,
+                              dx,
+                              probLo,
+                              minElectricField,
+                              maxElectricField,
+                              minGradElectricField,
+                              maxGradElectricField);
     }
   }
 
@@ -219,4 +166,96 @@ CdrPlasmaFieldTagger::computeTracers() const
   this->deallocateStorage();
 }
 
+void
+CdrPlasmaFieldTagger::computeTracersBox(Vector<EBCellFAB*>& a_tracers,
+                                        const EBCellFAB&    a_electricField,
+                                        const EBCellFAB&    a_gradElectricField,
+                                        const int           a_lvl,
+                                        const DataIndex     a_dit,
+                                        const Box           a_box,
+                                        const EBISBox&      a_ebisbox,
+                                        const Real          a_time,
+                                        const Real          a_dx,
+                                        const RealVect      a_probLo,
+                                        const Real          a_minElectricField,
+                                        const Real          a_maxElectricField,
+                                        const Real          a_minGradElectricField,
+                                        const Real          a_maxGradElectricField) const
+{
+  CH_TIME("CdrPlasmaFieldTagger::computeTracersBox(...)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeTracersBox(...)" << endl;
+  }
+
+  constexpr int comp = 0;
+
+  // Single-valued data.
+  const FArrayBox& electricFieldReg     = a_electricField.getFArrayBox();
+  const FArrayBox& gradElectricFieldReg = a_gradElectricField.getFArrayBox();
+
+  Vector<FArrayBox*> trReg;
+  for (int i = 0; i < m_numTracers; i++) {
+    trReg.push_back(&(a_tracers[i]->getFArrayBox()));
+  }
+
+  // Regular kernel
+  auto regularKernel = [&](const IntVect& iv) -> void {
+    const RealVect pos = a_probLo + (0.5 * RealVect::Unit + RealVect(iv)) * a_dx;
+
+    // Reconstruct the electric field and gradient of the electric field.
+    const RealVect E = RealVect(D_DECL(electricFieldReg(iv, 0), electricFieldReg(iv, 1), electricFieldReg(iv, 2)));
+    const RealVect gradE =
+      RealVect(D_DECL(gradElectricFieldReg(iv, 0), gradElectricFieldReg(iv, 1), gradElectricFieldReg(iv, 2)));
+
+    // Call the per-point tracer function. This is a pure function.
+    const Vector<Real> tracers = this->tracer(pos,
+                                              a_time,
+                                              a_dx,
+                                              E,
+                                              a_minElectricField,
+                                              a_maxElectricField,
+                                              gradE,
+                                              a_minGradElectricField,
+                                              a_maxGradElectricField);
+
+    // Put the tracer field where it belongs.
+    for (int i = 0; i < m_numTracers; i++) {
+      (*trReg[i])(iv, comp) = tracers[i];
+    }
+  };
+
+  // Irregular box loop
+  auto irregularKernel = [&](const VolIndex& vof) -> void {
+    const RealVect pos = a_probLo + Location::position(Location::Cell::Center, vof, a_ebisbox, a_dx);
+
+    // Reconstruct the electric field and gradient of the electric field.
+    const RealVect E = RealVect(D_DECL(a_electricField(vof, 0), a_electricField(vof, 1), a_electricField(vof, 2)));
+    const RealVect gradE =
+      RealVect(D_DECL(a_gradElectricField(vof, 0), a_gradElectricField(vof, 1), a_gradElectricField(vof, 2)));
+
+    // Call the per-point tracer function. Again, it's a pure function.
+    const Vector<Real> tracers = this->tracer(pos,
+                                              a_time,
+                                              a_dx,
+                                              E,
+                                              a_minElectricField,
+                                              a_maxElectricField,
+                                              gradE,
+                                              a_minGradElectricField,
+                                              a_maxGradElectricField);
+
+    // Put the tracer field where it belongs.
+    for (int i = 0; i < m_numTracers; i++) {
+      (*a_tracers[i])(vof, comp) = tracers[i];
+    }
+  };
+
+  // Irregular kernel region
+  VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[a_dit];
+
+  // Execute the kernels
+  BoxLoops::loop(a_box, regularKernel);
+  BoxLoops::loop(vofit, irregularKernel);
+}
+
 #include <CD_NamespaceFooter.H>
@@ -178,8 +178,8 @@ CdrPlasmaStepper::computeCellConductivity(EBAMRCellData& a_cellConductivity) con
   EBAMRCellData fieldMagnitude;
   EBAMRCellData speciesConductivity;
 
-  m_amr->allocate(fieldMagnitude, m_realm, m_phase, 1);
-  m_amr->allocate(speciesConductivity, m_realm, m_phase, 1);
+  m_amr->allocateScratch(fieldMagnitude, m_realm, m_phase, 1);
+  m_amr->allocateScratch(speciesConductivity, m_realm, m_phase, 1);
 
   // Compute the electric field magnitude
   DataOps::vectorLength(fieldMagnitude, cellCenteredElectricField);
@@ -400,7 +400,7 @@ CdrPlasmaStepper::advanceReactionNetwork(const Real a_time, const Real a_dt)
 
   // Compute the electric field on the compute phase.
   EBAMRCellData E;
-  m_amr->allocate(E, m_realm, m_cdr->getPhase(), SpaceDim);
+  m_amr->allocateScratch(E, m_realm, m_cdr->getPhase(), SpaceDim);
   this->computeElectricField(E, m_cdr->getPhase(), m_fieldSolver->getPotential());
 
   // Get the source terms and densities from the solvers.
@@ -435,7 +435,7 @@ CdrPlasmaStepper::advanceReactionNetwork(Vector<EBAMRCellData*>&       a_cdrSour
 
   // Allocate scratch data which we will use to compute the gradient.
   EBAMRCellData scratch;
-  m_amr->allocate(scratch, m_realm, m_cdr->getPhase(), 1);
+  m_amr->allocateScratch(scratch, m_realm, m_cdr->getPhase(), 1);
 
   // Number of CDR solvers.
   const int numCdrSpecies = m_physics->getNumCdrSpecies();
@@ -1401,8 +1401,8 @@ CdrPlasmaStepper::computeCdrDiffusion()
   EBAMRCellData electricFieldCell;
   EBAMRIVData   electricFieldEB;
 
-  m_amr->allocate(electricFieldCell, m_realm, m_cdr->getPhase(), SpaceDim);
-  m_amr->allocate(electricFieldEB, m_realm, m_cdr->getPhase(), SpaceDim);
+  m_amr->allocateScratch(electricFieldCell, m_realm, m_cdr->getPhase(), SpaceDim);
+  m_amr->allocateScratch(electricFieldEB, m_realm, m_cdr->getPhase(), SpaceDim);
 
   // Compute field on cell center and on EB centroid.
   this->computeElectricField(electricFieldCell, m_cdr->getPhase(), m_fieldSolver->getPotential());
@@ -1964,7 +1964,7 @@ CdrPlasmaStepper::computeCdrDriftVelocities()
 
   // Compute the electric field first.
   EBAMRCellData E;
-  m_amr->allocate(E, m_realm, m_cdr->getPhase(), SpaceDim);
+  m_amr->allocateScratch(E, m_realm, m_cdr->getPhase(), SpaceDim);
   this->computeElectricField(E, m_cdr->getPhase(), m_fieldSolver->getPotential());
 
   // Get handle to CDR drift velocities and densities.
@@ -2707,9 +2707,9 @@ CdrPlasmaStepper::computeExtrapolatedFluxes(Vector<EBAMRIVData*>&        a_extra
   EBAMRIVData ebVel;
   EBAMRIVData ebPhi;
 
-  m_amr->allocate(ebFlux, m_realm, a_phase, SpaceDim);
-  m_amr->allocate(ebVel, m_realm, a_phase, SpaceDim);
-  m_amr->allocate(ebPhi, m_realm, a_phase, 1);
+  m_amr->allocateScratch(ebFlux, m_realm, a_phase, SpaceDim);
+  m_amr->allocateScratch(ebVel, m_realm, a_phase, SpaceDim);
+  m_amr->allocateScratch(ebPhi, m_realm, a_phase, 1);
 
   // This stencil takes cell centered data and puts it on the centroid.
   const IrregAmrStencil<EbCentroidInterpolationStencil>& interpStencils =
@@ -2819,7 +2819,7 @@ CdrPlasmaStepper::computeExtrapolatedVelocities(Vector<EBAMRIVData*>&        a_c
 
   // Allocate some scratch data -- it is used for extrapolating the vell-centered data to the EB.
   EBAMRIVData scratch;
-  m_amr->allocate(scratch, m_realm, a_phase, SpaceDim);
+  m_amr->allocateScratch(scratch, m_realm, a_phase, SpaceDim);
 
   //  for (int i = 0; i < a_cdrVelocitiesEB.size(); i++){
   for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
@@ -2953,8 +2953,8 @@ CdrPlasmaStepper::computeJ(EBAMRCellData& a_J) const
   EBAMRCellData scratchONE;
   EBAMRCellData scratchDIM;
 
-  m_amr->allocate(scratchONE, m_realm, m_phase, 1);
-  m_amr->allocate(scratchDIM, m_realm, m_phase, SpaceDim);
+  m_amr->allocateScratch(scratchONE, m_realm, m_phase, 1);
+  m_amr->allocateScratch(scratchDIM, m_realm, m_phase, SpaceDim);
 
   for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
     const RefCountedPtr<CdrSolver>&  solver  = solverIt();
@@ -3144,7 +3144,7 @@ CdrPlasmaStepper::computeMaxElectricField(Real& a_maximumElectricField, const ph
 
   // Compute the electric field on the input phase and interpolate it to centroids.
   EBAMRCellData E;
-  m_amr->allocate(E, m_realm, a_phase, SpaceDim);
+  m_amr->allocateScratch(E, m_realm, a_phase, SpaceDim);
 
   this->computeElectricField(E, a_phase, m_fieldSolver->getPotential());
   m_amr->interpToCentroids(E, m_realm, a_phase);
@@ -4063,7 +4063,7 @@ CdrPlasmaStepper::computeElectrodeCurrent()
 
   // Allocate a data holder for storing the total charge flux, i.e. J.
   EBAMRIVData currentDensity;
-  m_amr->allocate(currentDensity, m_realm, m_cdr->getPhase(), 1);
+  m_amr->allocateScratch(currentDensity, m_realm, m_cdr->getPhase(), 1);
   DataOps::setValue(currentDensity, 0.0);
 
   // Iterate through all CDR solvers and add their EB BC flux to the current density data holder.
@@ -4144,7 +4144,7 @@ CdrPlasmaStepper::computeDielectricCurrent()
 
   // Allocate a data holder for storing the total charge flux, i.e. J.
   EBAMRIVData currentDensity;
-  m_amr->allocate(currentDensity, m_realm, m_cdr->getPhase(), 1);
+  m_amr->allocateScratch(currentDensity, m_realm, m_cdr->getPhase(), 1);
   DataOps::setValue(currentDensity, 0.0);
 
   // Iterate through all CDR solvers and add their EB BC flux to the current density data holder.
@@ -4302,9 +4302,9 @@ CdrPlasmaStepper::computeOhmicInductionCurrent()
   EBAMRCellData E;
   EBAMRCellData JdotE;
 
-  m_amr->allocate(J, m_realm, m_phase, SpaceDim);
-  m_amr->allocate(E, m_realm, m_phase, SpaceDim);
-  m_amr->allocate(JdotE, m_realm, m_phase, 1);
+  m_amr->allocateScratch(J, m_realm, m_phase, SpaceDim);
+  m_amr->allocateScratch(E, m_realm, m_phase, SpaceDim);
+  m_amr->allocateScratch(JdotE, m_realm, m_phase, 1);
 
   // Compute the electric field and the current density.
   this->computeElectricField(E, m_cdr->getPhase(), m_fieldSolver->getPotential());
@@ -4342,8 +4342,8 @@ CdrPlasmaStepper::computeRelaxationTime()
   EBAMRCellData relaxTime;
   EBAMRCellData conductivity;
 
-  m_amr->allocate(relaxTime, m_realm, phase::gas, 1);
-  m_amr->allocate(conductivity, m_realm, phase::gas, 1);
+  m_amr->allocateScratch(relaxTime, m_realm, phase::gas, 1);
+  m_amr->allocateScratch(conductivity, m_realm, phase::gas, 1);
 
   // Compute the conductivity.
   this->computeCellConductivity(conductivity);
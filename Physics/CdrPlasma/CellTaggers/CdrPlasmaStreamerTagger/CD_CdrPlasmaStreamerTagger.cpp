@@ -14,6 +14,8 @@
 
 // Our includes
 #include <CD_CdrPlasmaStreamerTagger.H>
+#include <CD_BoxLoops.H>
+#include <CD_Location.H>
 #include <CD_NamespaceHeader.H>
 
 using namespace Physics::CdrPlasma;
@@ -98,6 +100,240 @@ CdrPlasmaStreamerTagger::tracer(const RealVect a_pos,
   return tracers;
 }
 
+void
+CdrPlasmaStreamerTagger::computeTracersBox(Vector<EBCellFAB*>& a_tracers,
+                                           const EBCellFAB&    a_electricField,
+                                           const EBCellFAB&    a_gradElectricField,
+                                           const int           a_lvl,
+                                           const DataIndex     a_dit,
+                                           const Box           a_box,
+                                           const EBISBox&      a_ebisbox,
+                                           const Real          a_time,
+                                           const Real          a_dx,
+                                           const RealVect      a_probLo,
+                                           const Real          a_minElectricField,
+                                           const Real          a_maxElectricField,
+                                           const Real          a_minGradElectricField,
+                                           const Real          a_maxGradElectricField) const
+{
+  CH_TIME("CdrPlasmaStreamerTagger::computeTracersBox(...)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaStreamerTagger::computeTracersBox(...)" << endl;
+  }
+
+  CH_assert(a_tracers.size() == 2);
+
+  constexpr int comp = 0;
+
+  // TLDR: This computes the same tracers as CdrPlasmaStreamerTagger::tracer, i.e. |E|/max(|E|) and the Townsend ionization coefficient, but
+  //       writes directly into the patch data.
+  EBCellFAB& fieldTracer = *a_tracers[0];
+  EBCellFAB& alphaTracer = *a_tracers[1];
+
+  FArrayBox&       fieldTracerReg   = fieldTracer.getFArrayBox();
+  FArrayBox&       alphaTracerReg   = alphaTracer.getFArrayBox();
+  const FArrayBox& electricFieldReg = a_electricField.getFArrayBox();
+
+  // Regular kernel.
+  auto regularKernel = [&](const IntVect& iv) -> void {
+    const RealVect pos = a_probLo + (0.5 * RealVect::Unit + RealVect(iv)) * a_dx;
+    const Real     E   = sqrt(D_TERM(electricFieldReg(iv, 0) * electricFieldReg(iv, 0),
+                                +electricFieldReg(iv, 1) * electricFieldReg(iv, 1),
+                                +electricFieldReg(iv, 2) * electricFieldReg(iv, 2)));
+
+    fieldTracerReg(iv, comp) = E / a_maxElectricField;
+    alphaTracerReg(iv, comp) = m_physics->computeAlpha(E, pos);
+  };
+
+  // Irregular kernel.
+  auto irregularKernel = [&](const VolIndex& vof) -> void {
+    const RealVect pos = a_probLo + Location::position(Location::Cell::Center, vof, a_ebisbox, a_dx);
+    const Real     E   = sqrt(D_TERM(a_electricField(vof, 0) * a_electricField(vof, 0),
+                                +a_electricField(vof, 1) * a_electricField(vof, 1),
+                                +a_electricField(vof, 2) * a_electricField(vof, 2)));
+
+    fieldTracer(vof, comp) = E / a_maxElectricField;
+    alphaTracer(vof, comp) = m_physics->computeAlpha(E, pos);
+  };
+
+  VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[a_dit];
+
+  BoxLoops::loop(a_box, regularKernel);
+  BoxLoops::loop(vofit, irregularKernel);
+}
+
+void
+CdrPlasmaStreamerTagger::refineCellsBox(DenseIntVectSet&          a_refinedCells,
+                                        const Vector<EBCellFAB*>& a_tracers,
+                                        const Vector<EBCellFAB*>& a_gradTracers,
+                                        const int                 a_lvl,
+                                        const DataIndex           a_dit,
+                                        const Box                 a_box,
+                                        const EBISBox&            a_ebisbox,
+                                        const Real                a_time,
+                                        const Real                a_dx,
+                                        const RealVect            a_probLo)
+{
+  CH_TIME("CdrPlasmaStreamerTagger::refineCellsBox(...)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaStreamerTagger::refineCellsBox(...)" << endl;
+  }
+
+  constexpr int comp = 0;
+
+  const EBCellFAB& fieldTracer = *a_tracers[0];
+  const EBCellFAB& alphaTracer = *a_tracers[1];
+  const EBCellFAB& fieldGrad   = *a_gradTracers[0];
+
+  const FArrayBox& fieldTracerReg = fieldTracer.getFArrayBox();
+  const FArrayBox& alphaTracerReg = alphaTracer.getFArrayBox();
+  const FArrayBox& fieldGradReg   = fieldGrad.getFArrayBox();
+
+  // If there are no tag boxes we can refine everywhere, so we don't need to check the cell positions.
+  const bool checkTagBoxes = m_tagBoxes.size() > 0;
+
+  // Regular kernel.
+  auto regularKernel = [&](const IntVect& iv) -> void {
+    if (a_ebisbox.isRegular(iv)) {
+      const Real grad = sqrt(D_TERM(fieldGradReg(iv, 0) * fieldGradReg(iv, 0),
+                                    +fieldGradReg(iv, 1) * fieldGradReg(iv, 1),
+                                    +fieldGradReg(iv, 2) * fieldGradReg(iv, 2)));
+
+      if (this->refineCriterion(a_dx, fieldTracerReg(iv, comp), alphaTracerReg(iv, comp), grad)) {
+        const RealVect pos = a_probLo + (0.5 * RealVect::Unit + RealVect(iv)) * a_dx;
+
+        if (!checkTagBoxes || this->insideTagBox(pos)) {
+          a_refinedCells |= iv;
+        }
+      }
+    }
+  };
+
+  // Irregular kernel.
+  auto irregularKernel = [&](const VolIndex& vof) -> void {
+    const Real grad = sqrt(D_TERM(fieldGrad(vof, 0) * fieldGrad(vof, 0),
+                                  +fieldGrad(vof, 1) * fieldGrad(vof, 1),
+                                  +fieldGrad(vof, 2) * fieldGrad(vof, 2)));
+
+    if (this->refineCriterion(a_dx, fieldTracer(vof, comp), alphaTracer(vof, comp), grad)) {
+      const RealVect pos = a_probLo + Location::position(Location::Cell::Center, vof, a_ebisbox, a_dx);
+
+      if (!checkTagBoxes || this->insideTagBox(pos)) {
+        a_refinedCells |= vof.gridIndex();
+      }
+    }
+  };
+
+  VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[a_dit];
+
+  BoxLoops::loop(a_box, regularKernel);
+  BoxLoops::loop(vofit, irregularKernel);
+}
+
+void
+CdrPlasmaStreamerTagger::coarsenCellsBox(DenseIntVectSet&          a_coarsenedCells,
+                                         const Vector<EBCellFAB*>& a_tracers,
+                                         const Vector<EBCellFAB*>& a_gradTracers,
+                                         const int                 a_lvl,
+                                         const DataIndex           a_dit,
+                                         const Box                 a_box,
+                                         const EBISBox&            a_ebisbox,
+                                         const Real                a_time,
+                                         const Real                a_dx,
+                                         const RealVect            a_probLo)
+{
+  CH_TIME("CdrPlasmaStreamerTagger::coarsenCellsBox(...)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaStreamerTagger::coarsenCellsBox(...)" << endl;
+  }
+
+  constexpr int comp = 0;
+
+  // TLDR: Cells outside the tag boxes are always coarsened. Inside the tag boxes we only coarsen on levels >= m_maxCoarsenLevel, so
+  //       if there are no tag boxes and we are below that level there is nothing to do.
+  const bool checkTagBoxes  = m_tagBoxes.size() > 0;
+  const bool checkCriterion = a_lvl >= m_maxCoarsenLevel;
+
+  if (!checkTagBoxes && !checkCriterion) {
+    return;
+  }
+
+  const EBCellFAB& fieldTracer = *a_tracers[0];
+  const EBCellFAB& alphaTracer = *a_tracers[1];
+  const EBCellFAB& fieldGrad   = *a_gradTracers[0];
+
+  const FArrayBox& fieldTracerReg = fieldTracer.getFArrayBox();
+  const FArrayBox& alphaTracerReg = alphaTracer.getFArrayBox();
+  const FArrayBox& fieldGradReg   = fieldGrad.getFArrayBox();
+
+  // Regular kernel.
+  auto regularKernel = [&](const IntVect& iv) -> void {
+    const bool isPointInside =
+      !checkTagBoxes || this->insideTagBox(a_probLo + (0.5 * RealVect::Unit + RealVect(iv)) * a_dx);
+
+    if (!isPointInside) {
+      a_coarsenedCells |= iv;
+    }
+    else if (checkCriterion && a_ebisbox.isRegular(iv)) {
+      const Real grad = sqrt(D_TERM(fieldGradReg(iv, 0) * fieldGradReg(iv, 0),
+                                    +fieldGradReg(iv, 1) * fieldGradReg(iv, 1),
+                                    +fieldGradReg(iv, 2) * fieldGradReg(iv, 2)));
+
+      if (this->coarsenCriterion(a_dx, fieldTracerReg(iv, comp), alphaTracerReg(iv, comp), grad)) {
+        a_coarsenedCells |= iv;
+      }
+    }
+  };
+
+  // Irregular kernel.
+  auto irregularKernel = [&](const VolIndex& vof) -> void {
+    const bool isPointInside =
+      !checkTagBoxes ||
+      this->insideTagBox(a_probLo + Location::position(Location::Cell::Center, vof, a_ebisbox, a_dx));
+
+    if (!isPointInside) {
+      a_coarsenedCells |= vof.gridIndex();
+    }
+    else if (checkCriterion) {
+      const Real grad = sqrt(D_TERM(fieldGrad(vof, 0) * fieldGrad(vof, 0),
+                                    +fieldGrad(vof, 1) * fieldGrad(vof, 1),
+                                    +fieldGrad(vof, 2) * fieldGrad(vof, 2)));
+
+      if (this->coarsenCriterion(a_dx, fieldTracer(vof, comp), alphaTracer(vof, comp), grad)) {
+        a_coarsenedCells |= vof.gridIndex();
+      }
+    }
+  };
+
+  VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[a_dit];
+
+  BoxLoops::loop(a_box, regularKernel);
+  BoxLoops::loop(vofit, irregularKernel);
+}
+
+bool
+CdrPlasmaStreamerTagger::refineCriterion(const Real a_dx,
+                                         const Real a_fieldTracer,
+                                         const Real a_alphaTracer,
+                                         const Real a_fieldGrad) const noexcept
+{
+  // TLDR: Refine if either criterion are met.
+  const bool refine1 = a_fieldGrad * a_dx / a_fieldTracer > m_refiCurv;
+  const bool refine2 = a_alphaTracer * a_dx > m_refiAlpha;
+
+  return refine1 || refine2;
+}
+
+bool
+CdrPlasmaStreamerTagger::coarsenCriterion(const Real a_dx,
+                                          const Real a_fieldTracer,
+                                          const Real a_alphaTracer,
+                                          const Real a_fieldGrad) const noexcept
+{
+  // TLDR: Coarsen if both criteria are met.
+  return a_fieldGrad * a_dx / a_fieldTracer < m_coarCurv && a_alphaTracer * a_dx < m_coarAlpha;
+}
+
 bool
 CdrPlasmaStreamerTagger::coarsenCell(const RealVect         a_pos,
                                      const Real             a_time,
@@ -108,10 +344,8 @@ CdrPlasmaStreamerTagger::coarsenCell(const RealVect         a_pos,
 {
   bool coarsen = false;
 
-  // TLDR: Coarsen if both criteria are met.
-
   if (a_lvl >= m_maxCoarsenLevel) {
-    coarsen = a_gradTracers[0].vectorLength() * a_dx / a_tracers[0] < m_coarCurv && a_tracers[1] * a_dx < m_coarAlpha;
+    coarsen = this->coarsenCriterion(a_dx, a_tracers[0], a_tracers[1], a_gradTracers[0].vectorLength());
   }
   else {
     coarsen = false;
@@ -128,12 +362,7 @@ CdrPlasmaStreamerTagger::refineCell(const RealVect         a_pos,
                                     const Vector<Real>     a_tracers,
                                     const Vector<RealVect> a_gradTracers) const
 {
-  // TLDR: Refine if either criterion are met.
-
-  const bool refine1 = a_gradTracers[0].vectorLength() * a_dx / a_tracers[0] > m_refiCurv;
-  const bool refine2 = a_tracers[1] * a_dx > m_refiAlpha;
-
-  return refine1 || refine2;
+  return this->refineCriterion(a_dx, a_tracers[0], a_tracers[1], a_gradTracers[0].vectorLength());
 }
 
 #include <CD_NamespaceFooter.H>
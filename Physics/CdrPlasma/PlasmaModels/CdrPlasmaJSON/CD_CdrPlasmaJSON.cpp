@@ -379,6 +379,9 @@ CdrPlasmaJSON::initializeNeutralSpecies()
   // For converting grams to kilograms
   constexpr Real g2kg = 1.E-3;
 
+  // Only the ideal gas law is constant in space.
+  m_isGasConstant = (gasLaw == "ideal");
+
   // Instantiate the pressure, density, and temperature of the gas. Note: The density  is the NUMBER density.
   if (gasLaw == "ideal") {
 
@@ -1069,8 +1072,11 @@ CdrPlasmaJSON::initializePhotonSpecies()
     m_rteSpeciesMap.emplace(std::make_pair(name, num));
     m_rteSpeciesInverseMap.emplace(std::make_pair(num, name));
 
+    // Absorption coefficients are constant if they do not depend on the gas pressure, or if the gas pressure is constant.
+    const bool constantKappa = (kappa == "constant") || (kappa == "helmholtz" && m_isGasConstant);
+
     // Push the JSON entry and the new CdrSpecies to corresponding vectors.
-    m_rtSpecies.push_back(RefCountedPtr<RtSpecies>(new RteSpeciesJSON(name, kappaFunction)));
+    m_rtSpecies.push_back(RefCountedPtr<RtSpecies>(new RteSpeciesJSON(name, kappaFunction, constantKappa)));
     m_rteSpeciesJSON.push_back(species);
   }
 }
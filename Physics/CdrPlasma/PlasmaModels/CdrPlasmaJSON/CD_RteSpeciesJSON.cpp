@@ -14,9 +14,11 @@
 
 using namespace Physics::CdrPlasma;
 
-RteSpeciesJSON::RteSpeciesJSON(const std::string& a_name, const RteSpeciesJSON::KappaFunction& a_kappaFunction)
+RteSpeciesJSON::RteSpeciesJSON(const std::string&                   a_name,
+                               const RteSpeciesJSON::KappaFunction& a_kappaFunction,
+                               const bool                           a_constantKappa)
 {
-  this->define(a_name, a_kappaFunction);
+  this->define(a_name, a_kappaFunction, a_constantKappa);
 }
 
 RteSpeciesJSON::~RteSpeciesJSON()
@@ -25,10 +27,13 @@ RteSpeciesJSON::~RteSpeciesJSON()
 }
 
 void
-RteSpeciesJSON::define(const std::string& a_name, const RteSpeciesJSON::KappaFunction& a_kappaFunction)
+RteSpeciesJSON::define(const std::string&                   a_name,
+                       const RteSpeciesJSON::KappaFunction& a_kappaFunction,
+                       const bool                           a_constantKappa)
 {
   m_name               = a_name;
   m_absorptionFunction = a_kappaFunction;
+  m_constantKappa      = a_constantKappa;
 }
 
 Real
@@ -37,4 +42,10 @@ RteSpeciesJSON::getAbsorptionCoefficient(const RealVect a_pos) const
   return m_absorptionFunction(a_pos);
 }
 
+bool
+RteSpeciesJSON::isAbsorptionCoefficientConstant() const noexcept
+{
+  return m_constantKappa;
+}
+
 #include <CD_NamespaceFooter.H>
@@ -10,6 +10,7 @@
 */
 
 // Std includes
+#include <cmath>
 #include <limits>
 
 // Chombo includes
@@ -39,6 +40,14 @@ CdrPlasmaGodunovStepper::CdrPlasmaGodunovStepper(RefCountedPtr<CdrPlasmaPhysics>
   m_physics      = a_physics;
   m_extrapAdvect = true;
   m_regridSlopes = true;
+  m_subcycle     = false;
+
+  m_adaptiveDt          = false;
+  m_haveAdaptiveStorage = false;
+  m_haveHistory         = false;
+  m_haveErrorEstimate   = false;
+  m_previousError       = -1.0;
+  m_previousDt          = -1.0;
 }
 
 CdrPlasmaGodunovStepper::~CdrPlasmaGodunovStepper()
@@ -75,6 +84,7 @@ CdrPlasmaGodunovStepper::parseOptions()
   this->parseProfile();
   this->parseFHD();
   this->parseRegridSlopes();
+  this->parseAdaptiveDt();
 }
 
 void
@@ -102,6 +112,7 @@ CdrPlasmaGodunovStepper::parseRuntimeOptions()
   this->parseProfile();
   this->parseFHD();
   this->parseRegridSlopes();
+  this->parseAdaptiveDt();
 
   // Solvers also parse their runtime options.
   m_cdr->parseRuntimeOptions();
@@ -205,6 +216,12 @@ CdrPlasmaGodunovStepper::parseAdvection()
   else {
     MayDay::Error("CdrPlasmaGodunovStepper::parseAdvection - unknown argument");
   }
+
+  pp.get("subcycle", m_subcycle);
+
+  if (m_subcycle && m_advectionSolver == AdvectionSolver::RK2) {
+    MayDay::Error("CdrPlasmaGodunovStepper::parseAdvection - subcycling is not supported with 'rk2' advection");
+  }
 }
 
 void
@@ -245,6 +262,7 @@ CdrPlasmaGodunovStepper::parseProfile()
   ParmParse pp(m_className.c_str());
 
   pp.get("profile", m_profile);
+  pp.get("trace", m_trace);
 }
 
 void
@@ -273,6 +291,36 @@ CdrPlasmaGodunovStepper::parseRegridSlopes()
   pp.get("use_regrid_slopes", m_regridSlopes);
 }
 
+void
+CdrPlasmaGodunovStepper::parseAdaptiveDt()
+{
+  CH_TIME("CdrPlasmaGodunovStepper::parseAdaptiveDt()");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::parseAdaptiveDt()" << endl;
+  }
+
+  ParmParse pp(m_className.c_str());
+
+  pp.get("adaptive_dt", m_adaptiveDt);
+  pp.get("max_error", m_errorTolerance);
+  pp.get("error_index", m_errorIndex);
+  pp.get("error_norm", m_errorNorm);
+  pp.get("safety", m_safety);
+  pp.get("max_growth", m_maxGrowth);
+  pp.get("max_shrink", m_maxShrink);
+  pp.get("max_cfl", m_maxCFL);
+  pp.get("pi_alpha", m_controllerAlpha);
+  pp.get("pi_beta", m_controllerBeta);
+  pp.get("max_retries", m_maxRetries);
+
+  if (m_errorTolerance <= 0.0) {
+    MayDay::Error("CdrPlasmaGodunovStepper::parseAdaptiveDt - 'max_error' must be > 0");
+  }
+  if (m_maxGrowth < 1.0 || m_maxShrink <= 0.0 || m_maxShrink >= 1.0) {
+    MayDay::Error("CdrPlasmaGodunovStepper::parseAdaptiveDt - must have 'max_growth' >= 1 and 0 < 'max_shrink' < 1");
+  }
+}
+
 RefCountedPtr<CdrStorage>&
 CdrPlasmaGodunovStepper::getCdrStorage(const CdrIterator<CdrSolver>& a_solverIt)
 {
@@ -302,10 +350,97 @@ CdrPlasmaGodunovStepper::advance(const Real a_dt)
   //    3. Solve the reactive problem.
   //    4. Solve the radiative transfer problem
   //    5. Put data back into solvers to prepare for the next time step.
+  //
+  // Steps 1-4 are done in advanceSplitStep. With adaptive time stepping we estimate the error after those steps, and
+  // if the step is rejected we restore the solvers and retry with a smaller time step.
 
   m_timer = std::make_unique<Timer>("CdrPlasmaGodunovStepper::advance");
+  m_timer->setTrace(m_trace);
+
+  Real actualDt = a_dt;
+
+  if (!m_adaptiveDt) {
+    CdrPlasmaGodunovStepper::advanceSplitStep(a_dt);
+  }
+  else {
+    if (!m_haveAdaptiveStorage) {
+      this->allocateAdaptiveStorage();
+    }
+
+    m_timer->startEvent("Store solvers");
+    CdrPlasmaGodunovStepper::storeSolvers();
+    m_timer->stopEvent("Store solvers");
+
+    const Timer::EventID errorEvent   = m_timer->getEventID("Error estimate");
+    const Timer::EventID restoreEvent = m_timer->getEventID("Restore solvers");
+
+    int  numRejections = 0;
+    bool acceptStep    = false;
+
+    while (!acceptStep) {
+      CdrPlasmaGodunovStepper::advanceSplitStep(actualDt);
+
+      m_timer->startEvent(errorEvent);
+      m_error    = CdrPlasmaGodunovStepper::computeError(actualDt);
+      acceptStep = CdrPlasmaGodunovStepper::computeNewDt(actualDt, m_error, numRejections);
+      m_timer->stopEvent(errorEvent);
+
+      if (!acceptStep) {
+        if (m_verbosity > 2) {
+          pout() << "CdrPlasmaGodunovStepper::advance -- rejecting step with dt = " << actualDt
+                 << " (error = " << m_error << "), retrying with dt = " << m_newDt << endl;
+        }
 
-  Timer timer("CdrPlasmaGodunovStepper::advance");
+        m_timer->startEvent(restoreEvent);
+        CdrPlasmaGodunovStepper::restoreSolvers();
+        m_timer->stopEvent(restoreEvent);
+
+        actualDt = m_newDt;
+        numRejections++;
+      }
+    }
+
+    // The state at the beginning of this step is the history for the next error estimate.
+    for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
+      const int idx = solverIt.index();
+
+      DataOps::copy(m_cdrHistory[idx], m_cdrPrevious[idx]);
+    }
+
+    m_haveHistory = true;
+    m_previousDt  = actualDt;
+  }
+
+  // 5. Update velocities and diffusion coefficients in order to prepare for the next time step.
+  m_timer->startEvent("Velocities");
+  CdrPlasmaGodunovStepper::computeCdrDriftVelocities(m_time + actualDt);
+  m_timer->stopEvent("Velocities");
+
+  m_timer->startEvent("Diffu-coeffs");
+  CdrPlasmaGodunovStepper::computeCdrDiffusionCoefficients(m_time + actualDt);
+  m_timer->stopEvent("Diffu-coeffs");
+
+  if (m_profile) {
+    m_timer->eventReport(pout(), false);
+  }
+
+  if (m_trace) {
+    char fileName[100];
+    sprintf(fileName, "%s.trace.step%07d.json", m_className.c_str(), m_timeStep);
+
+    m_timer->writeTrace(fileName);
+  }
+
+  return actualDt;
+}
+
+void
+CdrPlasmaGodunovStepper::advanceSplitStep(const Real a_dt)
+{
+  CH_TIME("CdrPlasmaGodunovStepper::advanceSplitStep(Real)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::advanceSplitStep(Real)" << endl;
+  }
 
   // 1. Solve the transport problem. Note that we call advanceTransport which holds the implementation. This differs for explicit and semi-implicit formulations.
   CdrPlasmaGodunovStepper::advanceTransport(a_dt);
@@ -342,21 +477,167 @@ CdrPlasmaGodunovStepper::advance(const Real a_dt)
   m_timer->startEvent("Post-step");
   CdrPlasmaGodunovStepper::postStep();
   m_timer->stopEvent("Post-step");
+}
 
-  // 5. Update velocities and diffusion coefficients in order to prepare for the next time step.
-  m_timer->startEvent("Velocities");
-  CdrPlasmaGodunovStepper::computeCdrDriftVelocities(m_time + a_dt);
-  m_timer->stopEvent("Velocities");
+void
+CdrPlasmaGodunovStepper::storeSolvers()
+{
+  CH_TIME("CdrPlasmaGodunovStepper::storeSolvers()");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::storeSolvers()" << endl;
+  }
 
-  m_timer->startEvent("Diffu-coeffs");
-  CdrPlasmaGodunovStepper::computeCdrDiffusionCoefficients(m_time + a_dt);
-  m_timer->stopEvent("Diffu-coeffs");
+  for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
 
-  if (m_profile) {
-    m_timer->eventReport(pout(), false);
+    DataOps::copy(m_cdrPrevious[idx], solverIt()->getPhi());
+  }
+
+  for (auto solverIt = m_rte->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    DataOps::copy(m_rtePrevious[idx], solverIt()->getPhi());
+  }
+
+  DataOps::copy(m_potentialPrevious, m_fieldSolver->getPotential());
+  DataOps::copy(m_sigmaPrevious, m_sigma->getPhi());
+}
+
+void
+CdrPlasmaGodunovStepper::restoreSolvers()
+{
+  CH_TIME("CdrPlasmaGodunovStepper::restoreSolvers()");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::restoreSolvers()" << endl;
+  }
+
+  for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    DataOps::copy(solverIt()->getPhi(), m_cdrPrevious[idx]);
+  }
+
+  for (auto solverIt = m_rte->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    DataOps::copy(solverIt()->getPhi(), m_rtePrevious[idx]);
+  }
+
+  DataOps::copy(m_fieldSolver->getPotential(), m_potentialPrevious);
+  DataOps::copy(m_sigma->getPhi(), m_sigmaPrevious);
+
+  // The transport step expects velocities and diffusion coefficients at the beginning of the time step.
+  CdrPlasmaGodunovStepper::computeElectricFieldIntoScratch();
+  CdrPlasmaGodunovStepper::computeCdrDriftVelocities(m_time);
+  CdrPlasmaGodunovStepper::computeCdrDiffusionCoefficients(m_time);
+}
+
+Real
+CdrPlasmaGodunovStepper::computeError(const Real a_dt)
+{
+  CH_TIME("CdrPlasmaGodunovStepper::computeError(Real)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::computeError(Real)" << endl;
+  }
+
+  // TLDR: We compare the solution with the linear extrapolation n^k + r*(n^k - n^(k-1)) through the two previous states, where
+  //       r = dt/dtPrev. Since the difference is proportional to dt*(dt + dtPrev) we rescale by dt/(dt + dtPrev) in order to get
+  //       an estimate which scales like the local error of a first order method. The relative error is computed on each
+  //       level and we use the largest one. Using the coarsest level only would hide the errors in refined regions (e.g. near
+  //       streamer heads), which is where the largest errors usually are.
+
+  if (!m_haveHistory || m_previousDt <= 0.0) {
+    return -1.0;
   }
 
-  return a_dt;
+  const Real r     = a_dt / m_previousDt;
+  const Real scale = a_dt / (a_dt + m_previousDt);
+
+  Real maxError = 0.0;
+
+  for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    if (idx == m_errorIndex || m_errorIndex < 0) {
+      RefCountedPtr<CdrStorage>& storage = CdrPlasmaGodunovStepper::getCdrStorage(solverIt);
+
+      const EBAMRCellData& phi   = solverIt()->getPhi();
+      EBAMRCellData&       error = storage->getScratch();
+
+      DataOps::copy(error, phi);
+      DataOps::incr(error, m_cdrPrevious[idx], -(1.0 + r));
+      DataOps::incr(error, m_cdrHistory[idx], r);
+
+      for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+        Real errorNorm;
+        Real phiNorm;
+
+        DataOps::norm(errorNorm, *error[lvl], m_amr->getDomains()[lvl], m_errorNorm);
+        DataOps::norm(phiNorm, *phi[lvl], m_amr->getDomains()[lvl], m_errorNorm);
+
+        if (phiNorm > 0.0) {
+          maxError = std::max(maxError, scale * errorNorm / phiNorm);
+        }
+      }
+    }
+  }
+
+  return maxError;
+}
+
+bool
+CdrPlasmaGodunovStepper::computeNewDt(const Real a_dt, const Real a_error, const int a_numRejections)
+{
+  CH_TIME("CdrPlasmaGodunovStepper::computeNewDt(Real, Real, int)");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::computeNewDt(Real, Real, int)" << endl;
+  }
+
+  // TLDR: The local error of the Godunov splitting is O(dt^2) so a rejected step is retried with the step that would give
+  //       err = safety*tolerance, i.e. dt*(tolerance/err)^(1/2). Accepted steps use a PI controller
+  //
+  //          dtNew = safety * dt * (tolerance/err)^alpha * (errPrev/tolerance)^beta
+  //
+  //       which reacts less violently to changes in the error. When there is no error estimate (first step, and the first step after
+  //       a regrid or restart) we accept the step and propose the same step again.
+
+  bool acceptStep = true;
+
+  if (a_error < 0.0) {
+    m_newDt = a_dt;
+
+    return acceptStep;
+  }
+
+  const Real errorRatio = std::max(a_error / m_errorTolerance, 1.E-10);
+
+  if (errorRatio <= 1.0) {
+    Real factor = m_safety * std::pow(errorRatio, -m_controllerAlpha);
+
+    if (m_previousError > 0.0) {
+      factor *= std::pow(m_previousError / m_errorTolerance, m_controllerBeta);
+    }
+
+    factor = std::max(m_maxShrink, std::min(m_maxGrowth, factor));
+
+    m_newDt = factor * a_dt;
+  }
+  else {
+    const Real factor = std::max(m_maxShrink, m_safety * std::pow(errorRatio, -0.5));
+
+    m_newDt = std::max(factor * a_dt, m_minDt);
+
+    // Accept the step anyways if we can't make the time step any smaller.
+    acceptStep = (a_numRejections >= m_maxRetries) || (a_dt <= m_minDt);
+  }
+
+  if (acceptStep) {
+    m_previousError = a_error;
+  }
+
+  m_haveErrorEstimate = true;
+
+  return acceptStep;
 }
 
 void
@@ -626,6 +907,11 @@ CdrPlasmaGodunovStepper::allocateInternals()
   DataOps::setValue(m_conductivityFactorCell, 0.0);
   DataOps::setValue(m_conductivityFactorFace, 0.0);
   DataOps::setValue(m_conductivityFactorEB, 0.0);
+
+  // Storage for rolling back rejected steps. This is also called after regrids, and the CDR history is then lost.
+  if (m_adaptiveDt) {
+    this->allocateAdaptiveStorage();
+  }
 }
 
 void
@@ -668,6 +954,75 @@ CdrPlasmaGodunovStepper::deallocateInternals()
   m_amr->deallocate(m_conductivityFactorCell);
   m_amr->deallocate(m_conductivityFactorFace);
   m_amr->deallocate(m_conductivityFactorEB);
+
+  if (m_haveAdaptiveStorage) {
+    this->deallocateAdaptiveStorage();
+  }
+}
+
+void
+CdrPlasmaGodunovStepper::allocateAdaptiveStorage()
+{
+  CH_TIME("CdrPlasmaGodunovStepper::allocateAdaptiveStorage()");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::allocateAdaptiveStorage()" << endl;
+  }
+
+  constexpr int nComp = 1;
+
+  const int numCdrSpecies = m_physics->getNumCdrSpecies();
+  const int numRteSpecies = m_physics->getNumRtSpecies();
+
+  m_cdrPrevious.resize(numCdrSpecies);
+  m_cdrHistory.resize(numCdrSpecies);
+  m_rtePrevious.resize(numRteSpecies);
+
+  for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    m_amr->allocate(m_cdrPrevious[idx], m_realm, m_cdr->getPhase(), nComp);
+    m_amr->allocate(m_cdrHistory[idx], m_realm, m_cdr->getPhase(), nComp);
+  }
+
+  for (auto solverIt = m_rte->iterator(); solverIt.ok(); ++solverIt) {
+    const int idx = solverIt.index();
+
+    m_amr->allocate(m_rtePrevious[idx], m_realm, m_rte->getPhase(), nComp);
+  }
+
+  m_amr->allocate(m_potentialPrevious, m_realm, nComp);
+  m_amr->allocate(m_sigmaPrevious, m_realm, m_cdr->getPhase(), nComp);
+
+  m_haveAdaptiveStorage = true;
+  m_haveHistory         = false;
+}
+
+void
+CdrPlasmaGodunovStepper::deallocateAdaptiveStorage()
+{
+  CH_TIME("CdrPlasmaGodunovStepper::deallocateAdaptiveStorage()");
+  if (m_verbosity > 5) {
+    pout() << "CdrPlasmaGodunovStepper::deallocateAdaptiveStorage()" << endl;
+  }
+
+  for (int i = 0; i < m_cdrPrevious.size(); i++) {
+    m_amr->deallocate(m_cdrPrevious[i]);
+    m_amr->deallocate(m_cdrHistory[i]);
+  }
+
+  for (int i = 0; i < m_rtePrevious.size(); i++) {
+    m_amr->deallocate(m_rtePrevious[i]);
+  }
+
+  m_cdrPrevious.resize(0);
+  m_cdrHistory.resize(0);
+  m_rtePrevious.resize(0);
+
+  m_amr->deallocate(m_potentialPrevious);
+  m_amr->deallocate(m_sigmaPrevious);
+
+  m_haveAdaptiveStorage = false;
+  m_haveHistory         = false;
 }
 
 void
@@ -1124,9 +1479,14 @@ CdrPlasmaGodunovStepper::advanceTransportExplicitField(const Real a_dt)
       switch (m_advectionSolver) {
       case AdvectionSolver::Euler: {
         // Advance is just phi^(k+1) = phi^k - dt*div(F)
-        solver->computeDivF(scratch, phi, 0.0, false, true, true);
+        if (m_subcycle) {
+          solver->advectSubcycled(phi, a_dt, false, true, true);
+        }
+        else {
+          solver->computeDivF(scratch, phi, 0.0, false, true, true);
 
-        DataOps::incr(phi, scratch, -a_dt);
+          DataOps::incr(phi, scratch, -a_dt);
+        }
 
         break;
       }
@@ -1140,17 +1500,25 @@ CdrPlasmaGodunovStepper::advanceTransportExplicitField(const Real a_dt)
         // Compute divF(phi)
         solver->computeDivF(scratch2, phi, 0.0, false, true, true);
 
-        // Make phi = phi^k + 0.5*dt * (scratch1 + scratch2)
-        DataOps::incr(phi, scratch, 0.5 * a_dt);
-        DataOps::incr(phi, scratch2, -0.5 * a_dt);
+        // Make phi = phi^k - 0.5*dt * (scratch1 + scratch2). This is done in a single pass over the data.
+        DataOps::compute(
+          phi,
+          [dt = a_dt](Real& p, const Real, const Real& s1, const Real& s2) -> void { p += 0.5 * dt * (s1 - s2); },
+          scratch,
+          scratch2);
 
         break;
       }
       case AdvectionSolver::MUSCL: {
         // Advance is phi^(k+1) = phi^k - dt*div(F). Almost like the Euler method except for the transverse slopes.
-        solver->computeDivF(scratch, phi, a_dt, false, true, true);
+        if (m_subcycle) {
+          solver->advectSubcycled(phi, a_dt, true, true, true);
+        }
+        else {
+          solver->computeDivF(scratch, phi, a_dt, false, true, true);
 
-        DataOps::incr(phi, scratch, -a_dt);
+          DataOps::incr(phi, scratch, -a_dt);
+        }
 
         break;
       }
@@ -1195,8 +1563,11 @@ CdrPlasmaGodunovStepper::advanceTransportExplicitField(const Real a_dt)
 
           solver->computeDivD(scratch2, phi, false, false, false);
 
-          DataOps::incr(phi, scratch, -0.5 * a_dt);
-          DataOps::incr(phi, scratch2, 0.5 * a_dt);
+          DataOps::compute(
+            phi,
+            [dt = a_dt](Real& p, const Real, const Real& s1, const Real& s2) -> void { p += 0.5 * dt * (s2 - s1); },
+            scratch,
+            scratch2);
         }
       }
     }
@@ -1312,11 +1683,12 @@ CdrPlasmaGodunovStepper::advanceCdrReactions(const Real a_dt)
     EBAMRCellData&       phi = solver->getPhi();
     const EBAMRCellData& src = solver->getSource();
 
-    DataOps::incr(phi, src, a_dt);
-
-    // Floor mass if asked for it. If running in debug mode we compute the mass before and after flooring it.
+    // Floor mass if asked for it. If running in debug mode we compute the mass before and after flooring it. Otherwise
+    // the increment and floor are done in a single pass over the data.
     if (m_floor) {
       if (m_debug) {
+        DataOps::incr(phi, src, a_dt);
+
         const Real massBefore = solver->computeMass();
 
         DataOps::floor(phi, 0.0);
@@ -1328,9 +1700,15 @@ CdrPlasmaGodunovStepper::advanceCdrReactions(const Real a_dt)
                << " mass = " << relMassDiff << endl;
       }
       else {
-        DataOps::floor(phi, 0.0);
+        DataOps::compute(
+          phi,
+          [dt = a_dt](Real& p, const Real, const Real& s) -> void { p = std::max(0.0, p + dt * s); },
+          src);
       }
     }
+    else {
+      DataOps::incr(phi, src, a_dt);
+    }
   }
 }
 
@@ -1436,8 +1814,11 @@ CdrPlasmaGodunovStepper::computeDt()
   Real dt = std::numeric_limits<Real>::max();
 
   // First, figure out what the transport time step must be for explicit and explicit-implicit methods.
+  //
+  // With subcycling, the advective time step is the level-wise advective time step scaled up to the coarsest level. Diffusion is not
+  // subcycled so it is still restricted by the finest level.
   if (m_diffusionAlgorithm == DiffusionAlgorithm::Explicit) {
-    const Real advectionDt = m_cdr->computeAdvectionDt();
+    const Real advectionDt = m_subcycle ? m_cdr->computeSubcycledAdvectionDt() : m_cdr->computeAdvectionDt();
     const Real diffusionDt = m_cdr->computeDiffusionDt();
 
     m_dtCFL = std::min(advectionDt, diffusionDt);
@@ -1456,7 +1837,7 @@ CdrPlasmaGodunovStepper::computeDt()
     }
   }
   else if (m_diffusionAlgorithm == DiffusionAlgorithm::Implicit) {
-    m_dtCFL    = m_cdr->computeAdvectionDt();
+    m_dtCFL    = m_subcycle ? m_cdr->computeSubcycledAdvectionDt() : m_cdr->computeAdvectionDt();
     m_timeCode = TimeCode::Advection;
 
     dt = m_cfl * m_dtCFL;
@@ -1480,9 +1861,17 @@ CdrPlasmaGodunovStepper::computeDt()
     for (auto solverIt = m_cdr->iterator(); solverIt.ok(); ++solverIt) {
       solverDt.emplace_back(std::numeric_limits<Real>::max());
 
-      advectionDt.emplace_back(solverIt()->computeAdvectionDt());
-      diffusionDt.emplace_back(solverIt()->computeDiffusionDt());
-      advectionDiffusionDt.emplace_back(solverIt()->computeAdvectionDiffusionDt());
+      if (m_subcycle) {
+        // Advection and diffusion are split when we subcycle, so the explicit advection-diffusion limit is the smallest of the two.
+        advectionDt.emplace_back(solverIt()->computeSubcycledAdvectionDt());
+        diffusionDt.emplace_back(solverIt()->computeDiffusionDt());
+        advectionDiffusionDt.emplace_back(std::min(advectionDt.back(), diffusionDt.back()));
+      }
+      else {
+        advectionDt.emplace_back(solverIt()->computeAdvectionDt());
+        diffusionDt.emplace_back(solverIt()->computeDiffusionDt());
+        advectionDiffusionDt.emplace_back(solverIt()->computeAdvectionDiffusionDt());
+      }
     }
 
     // Next, run through the CDR solvers and switch to implicit diffusion for the solvers that satisfy the threshold.
@@ -1541,11 +1930,30 @@ CdrPlasmaGodunovStepper::computeDt()
     m_dtCFL = dt / m_cfl;
   }
 
+  // With adaptive time stepping the step is selected by the error controller, which may exceed the CFL number and relaxation time
+  // limits above. We still limit by max_cfl times the stability limit, and by the relaxation time when the field coupling is explicit.
+  const bool useErrorController = m_adaptiveDt && m_haveErrorEstimate;
+
+  if (useErrorController) {
+    const Real maxDtCFL = m_maxCFL * m_dtCFL;
+
+    if (m_newDt < maxDtCFL) {
+      dt         = m_newDt;
+      m_timeCode = TimeCode::Error;
+    }
+    else {
+      dt         = maxDtCFL;
+      m_timeCode = TimeCode::Restricted;
+    }
+  }
+
   // Next, limit by the relaxation time.
-  const Real dtRelax = m_relaxTime * this->computeRelaxationTime();
-  if (dtRelax < dt) {
-    dt         = dtRelax;
-    m_timeCode = TimeCode::RelaxationTime;
+  if (!useErrorController || m_fieldCoupling == FieldCoupling::Explicit) {
+    const Real dtRelax = m_relaxTime * this->computeRelaxationTime();
+    if (dtRelax < dt) {
+      dt         = dtRelax;
+      m_timeCode = TimeCode::RelaxationTime;
+    }
   }
 
   // Limit by lower hardcap.
@@ -53,7 +53,8 @@ def write_template(args):
 
     mainf.write("\n")
     mainf.write("#ifdef CH_MPI\n")
-    mainf.write("  MPI_Init(&argc, &argv);\n")
+    mainf.write("  int provided = MPI_THREAD_SINGLE;\n")
+    mainf.write("  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);\n")
     mainf.write("#endif\n")
     
     mainf.write("\n")
@@ -294,13 +294,13 @@ ItoPlasmaStepper::postCheckpointPoisson()
   m_amr->alias(E, m_phase, m_fieldSolver->getElectricField());
 
   // Fluid Realm
-  m_fluid_E.copy(E);
+  m_amr->copyData(m_fluid_E, E);
   m_amr->averageDown(m_fluid_E, m_fluid_Realm, m_phase);
   m_amr->interpGhostPwl(m_fluid_E, m_fluid_Realm, m_phase);
   m_amr->interpToCentroids(m_fluid_E, m_fluid_Realm, m_phase);
 
   // Particle Realm
-  m_particle_E.copy(E);
+  m_amr->copyData(m_particle_E, E);
   m_amr->averageDown(m_particle_E, m_particleRealm, m_phase);
   m_amr->interpGhostPwl(m_particle_E, m_particleRealm, m_phase);
   m_amr->interpToCentroids(m_particle_E, m_particleRealm, m_phase);
@@ -1110,7 +1110,7 @@ ItoPlasmaStepper::computeSpaceChargeDensity(MFAMRCellData& a_rho, const Vector<E
     const int                        q       = species->getChargeNumber();
 
     if (species->getChargeNumber() != 0) {
-      m_fluid_scratch1.copy(*a_densities[idx]);
+      m_amr->copyData(m_fluid_scratch1, *a_densities[idx]);
       DataOps::incr(rhoPhase, m_fluid_scratch1, q);
     }
   }
@@ -1178,7 +1178,7 @@ ItoPlasmaStepper::computeConductivity(EBAMRCellData&
       solver->depositConductivity(m_particle_scratch1, *a_particles[idx]);
 
       // Copy to fluid Realm and add to fluid stuff
-      m_fluid_scratch1.copy(m_particle_scratch1);
+      m_amr->copyData(m_fluid_scratch1, m_particle_scratch1);
       DataOps::incr(a_conductivity, m_fluid_scratch1, Abs(q));
     }
   }
@@ -1322,13 +1322,13 @@ ItoPlasmaStepper::solvePoisson()
   m_amr->alias(E, m_phase, m_fieldSolver->getElectricField());
 
   // Fluid Realm
-  m_fluid_E.copy(E);
+  m_amr->copyData(m_fluid_E, E);
   m_amr->averageDown(m_fluid_E, m_fluid_Realm, m_phase);
   m_amr->interpGhostPwl(m_fluid_E, m_fluid_Realm, m_phase);
   m_amr->interpToCentroids(m_fluid_E, m_fluid_Realm, m_phase);
 
   // Particle Realm
-  m_particle_E.copy(E);
+  m_amr->copyData(m_particle_E, E);
   m_amr->averageDown(m_particle_E, m_particleRealm, m_phase);
   m_amr->interpGhostPwl(m_particle_E, m_particleRealm, m_phase);
   m_amr->interpToCentroids(m_particle_E, m_particleRealm, m_phase);
@@ -1983,11 +1983,17 @@ ItoPlasmaStepper::computeItoDiffusionLFA(Vector<EBAMRCellData*>&       a_diffusi
   // TLDR: In this routine we make m_fscratch1 hold the diffusion coefficients on the fluid Realm and m_fscratch2 hold the particle densities on the fluid Realm.
   //       This requires a couple of copies.
 
-  // 1. Copy particle Realm densities to fluid Realm scratch data.
+  // 1. Copy particle Realm densities to fluid Realm scratch data. All transfers are posted before any of them are completed.
   for (auto solver_it = m_ito->iterator(); solver_it.ok(); ++solver_it) {
     const int idx = solver_it.index();
 
-    m_fscratch2[idx].copy(*a_densities[idx]);
+    m_amr->copyDataBegin(m_fscratch2[idx], *a_densities[idx]);
+  }
+
+  for (auto solver_it = m_ito->iterator(); solver_it.ok(); ++solver_it) {
+    const int idx = solver_it.index();
+
+    m_amr->copyDataEnd(m_fscratch2[idx], *a_densities[idx]);
   }
 
   // 2. Compute on each level. On the fluid Realm.
@@ -2006,23 +2012,29 @@ ItoPlasmaStepper::computeItoDiffusionLFA(Vector<EBAMRCellData*>&       a_diffusi
     this->computeItoDiffusionLFA(diffco_funcs, densities, *m_fluid_E[lvl], lvl, a_time);
   }
 
-  // Average down, interpolate ghost cells, and then interpolate to particle positions
+  // Average down, interpolate ghost cells, and then interpolate to particle positions. We copy to the particle Realm and average
+  // down there, then interpolate. All copies are posted first, so that the next species' transfer is in flight while we process
+  // the current one.
+  //
+  // In principle, we should be able to average down and interpolate ghost cells on the fluid Realm, and copy the entire result over
+  // to the particle Realm.
+  for (auto solver_it = m_ito->iterator(); solver_it.ok(); ++solver_it) {
+    const int idx = solver_it.index();
+
+    if (solver_it()->isDiffusive()) {
+      m_amr->copyDataBegin(*a_diffusionCoefficient_funcs[idx], m_fscratch1[idx]);
+    }
+  }
+
   for (auto solver_it = m_ito->iterator(); solver_it.ok(); ++solver_it) {
     const int                 idx    = solver_it.index();
     RefCountedPtr<ItoSolver>& solver = solver_it();
 
     if (solver->isDiffusive()) {
-
-#if 0 // In principle, we should be able to average down and interpolate ghost cells on the fluid Realm, and copy the entire result over to the particle Realm.
-      m_amr->averageDown(m_fscratch1[idx], m_fluid_Realm, m_phase);
-      m_amr->interpGhost(m_fscratch2[idx], m_fluid_Realm, m_phase);
-      a_diffusionCoefficient_funcs[idx]->copy(m_fluid_scratch1[idx]);
-#else // Instead, we copy to the particle Realm and average down there, then interpolate.
-      a_diffusionCoefficient_funcs[idx]->copy(m_fscratch1[idx]);
+      m_amr->copyDataEnd(*a_diffusionCoefficient_funcs[idx], m_fscratch1[idx]);
 
       m_amr->averageDown(*a_diffusionCoefficient_funcs[idx], m_particleRealm, m_phase);
       m_amr->interpGhost(*a_diffusionCoefficient_funcs[idx], m_particleRealm, m_phase);
-#endif
 
       solver->interpolateDiffusion();
     }
@@ -2379,16 +2391,23 @@ ItoPlasmaStepper::advanceReactionNetworkNWO(const EBAMRCellData& a_E, const EBAM
   }
 
   // 1. Compute the number of particles per cell. Set the number of Photons to be generated per cell to zero.
+  //    The particles per cell are sent to the fluid Realm while we compute the mean energies, and the particle Realm initialization
+  //    is done while both transfers are in flight.
   this->computeReactiveParticlesPerCell(m_particle_ppc);
+
+  m_amr->copyDataBegin(m_fluid_ppc, m_particle_ppc);
+
   this->computeReactiveMeanEnergiesPerCell(m_particle_eps);
 
-  m_fluid_ppc.copy(m_particle_ppc);
-  m_fluid_eps.copy(m_particle_eps);
+  m_amr->copyDataBegin(m_fluid_eps, m_particle_eps);
 
   DataOps::setValue(m_fluid_ypc, 0.0);
   DataOps::setValue(m_particle_ypc, 0.0);
   DataOps::copy(m_particle_old, m_particle_ppc);
 
+  m_amr->copyDataEnd(m_fluid_ppc, m_particle_ppc);
+  m_amr->copyDataEnd(m_fluid_eps, m_particle_eps);
+
   // 2. Solve for the new number of particles per cell. This also obtains the number of Photons to be generated in each cell.
   for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
     this->advanceReactionNetworkNWO(*m_fluid_ppc[lvl],
@@ -2401,9 +2420,13 @@ ItoPlasmaStepper::advanceReactionNetworkNWO(const EBAMRCellData& a_E, const EBAM
   }
 
   // 3. Copy the results to the particle Realm.
-  m_particle_ppc.copy(m_fluid_ppc);
-  m_particle_ypc.copy(m_fluid_ypc);
-  m_particle_eps.copy(m_fluid_eps);
+  m_amr->copyDataBegin(m_particle_ppc, m_fluid_ppc);
+  m_amr->copyDataBegin(m_particle_ypc, m_fluid_ypc);
+  m_amr->copyDataBegin(m_particle_eps, m_fluid_eps);
+
+  m_amr->copyDataEnd(m_particle_ppc, m_fluid_ppc);
+  m_amr->copyDataEnd(m_particle_ypc, m_fluid_ypc);
+  m_amr->copyDataEnd(m_particle_eps, m_fluid_eps);
 
   // 4. Reconcile particles on the particle Realm. Not implemented (yet).
   this->reconcileParticles(m_particle_ppc, m_particle_old, m_particle_eps, m_particle_ypc);
@@ -3546,7 +3569,7 @@ ItoPlasmaStepper::computeEdotJSourceNWO()
     if (q != 0 && solver->isMobile()) {
       solver->depositConductivity(m_particle_scratch1,
                                   solver->getParticles(ItoSolver::WhichContainer::Bulk)); // Deposit mu*n
-      m_fluid_scratch1.copy(m_particle_scratch1);                                         // Copy mu*n to fluid Realm
+      m_amr->copyData(m_fluid_scratch1, m_particle_scratch1);                             // Copy mu*n to fluid Realm
       DataOps::copy(m_fluid_scratchD, m_fluid_E);                                         // m_fluid_scratchD = E
       DataOps::multiplyScalar(m_fluid_scratchD, m_fluid_scratch1);                        // m_fluid_scratchD = E*mu*n
       DataOps::dotProduct(m_fluid_scratch1, m_fluid_E, m_fluid_scratchD); // m_particle_scratch1 = E.dot.(E*mu*n)
@@ -3561,7 +3584,7 @@ ItoPlasmaStepper::computeEdotJSourceNWO()
     if (q != 0 && solver->isDiffusive()) {
       solver->depositDiffusivity(m_particle_scratch1,
                                  solver->getParticles(ItoSolver::WhichContainer::Bulk)); // Deposit D*n
-      m_fluid_scratch1.copy(m_particle_scratch1);                                        // Copy D*n to fluid Realm
+      m_amr->copyData(m_fluid_scratch1, m_particle_scratch1);                            // Copy D*n to fluid Realm
       m_amr->interpGhostMG(m_fluid_scratch1, m_fluid_Realm, m_phase);
       m_amr->computeGradient(m_fluid_scratchD, m_fluid_scratch1, m_fluid_Realm, m_phase); // scratchD = grad(D*n)
       DataOps::scale(m_fluid_scratchD, -1.0);                                             // scratchD = -grad(D*n)
@@ -3641,7 +3664,7 @@ ItoPlasmaStepper::computeEdotJSourceNWO2(const Real a_dt)
 
       // Deposit the result
       solver->depositParticles(m_particle_scratch1, particles, deposition);
-      m_fluid_scratch1.copy(m_particle_scratch1);
+      m_amr->copyData(m_fluid_scratch1, m_particle_scratch1);
 
       // Scale by Qe/dt to make it Joule/dt. Then add to correct index
       DataOps::scale(m_fluid_scratch1, q * Units::Qe / a_dt);
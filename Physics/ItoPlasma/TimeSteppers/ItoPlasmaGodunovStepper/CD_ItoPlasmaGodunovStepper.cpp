@@ -1001,7 +1001,7 @@ ItoPlasmaGodunovStepper::compute_cell_conductivity(
 #endif
 
       // Copy to fluid Realm and add to fluid stuff
-      m_fluid_scratch1.copy(m_particle_scratch1);
+      m_amr->copyData(m_fluid_scratch1, m_particle_scratch1);
       DataOps::incr(a_conductivity, m_fluid_scratch1, Abs(q));
     }
   }
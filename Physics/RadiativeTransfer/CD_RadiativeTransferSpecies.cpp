@@ -33,7 +33,8 @@ RadiativeTransferSpecies::RadiativeTransferSpecies()
   pp.get("kappa", kappa);
 
   // Set the spatially varying absorption coefficient to a constant.
-  m_kappa = [kappa](const RealVect a_pos) -> Real { return kappa; };
+  m_kappa         = [kappa](const RealVect a_pos) -> Real { return kappa; };
+  m_constantKappa = true;
 }
 
 RadiativeTransferSpecies::~RadiativeTransferSpecies()
@@ -47,4 +48,10 @@ RadiativeTransferSpecies::getAbsorptionCoefficient(const RealVect a_pos) const
   return m_kappa(a_pos);
 }
 
+bool
+RadiativeTransferSpecies::isAbsorptionCoefficientConstant() const noexcept
+{
+  return m_constantKappa;
+}
+
 #include <CD_NamespaceFooter.H>
@@ -26,6 +26,7 @@
 #include <CD_DomainFluxIFFABFactory.H>
 #include <CD_TiledMeshRefine.H>
 #include <CD_DataOps.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 AmrMesh::AmrMesh()
@@ -42,7 +43,7 @@ AmrMesh::AmrMesh()
   m_refinementRatios.push_back(2);
 }
 
-AmrMesh::~AmrMesh() {}
+AmrMesh::~AmrMesh() { MemoryReport::releaseMemory(this); }
 
 EBAMRCellData
 AmrMesh::alias(const phase::which_phase a_phase, const MFAMRCellData& a_mfdata) const
@@ -339,6 +340,71 @@ AmrMesh::allocate(EBAMRIFData&             a_data,
   a_data.setRealm(a_realm);
 }
 
+void
+AmrMesh::allocateScratch(EBAMRCellData&           a_data,
+                         const std::string        a_realm,
+                         const phase::which_phase a_phase,
+                         const int                a_nComp,
+                         const int                a_ghost) const
+{
+  CH_TIME("AmrMesh::allocateScratch(EBAMRCellData, string, phase::which_phase, int, int)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::allocateScratch(EBAMRCellData, string, phase::which_phase, int, int)" << endl;
+  }
+
+  const int ghost = (a_ghost < 0) ? m_numGhostCells : a_ghost;
+
+  this->fetchScratch(a_data, m_scratchCell, a_realm, a_phase, a_nComp, ghost);
+}
+
+void
+AmrMesh::allocateScratch(EBAMRFluxData&           a_data,
+                         const std::string        a_realm,
+                         const phase::which_phase a_phase,
+                         const int                a_nComp,
+                         const int                a_ghost) const
+{
+  CH_TIME("AmrMesh::allocateScratch(EBAMRFluxData, string, phase::which_phase, int, int)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::allocateScratch(EBAMRFluxData, string, phase::which_phase, int, int)" << endl;
+  }
+
+  const int ghost = (a_ghost < 0) ? m_numGhostCells : a_ghost;
+
+  this->fetchScratch(a_data, m_scratchFlux, a_realm, a_phase, a_nComp, ghost);
+}
+
+void
+AmrMesh::allocateScratch(EBAMRIVData&             a_data,
+                         const std::string        a_realm,
+                         const phase::which_phase a_phase,
+                         const int                a_nComp,
+                         const int                a_ghost) const
+{
+  CH_TIME("AmrMesh::allocateScratch(EBAMRIVData, string, phase::which_phase, int, int)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::allocateScratch(EBAMRIVData, string, phase::which_phase, int, int)" << endl;
+  }
+
+  const int ghost = (a_ghost < 0) ? m_numGhostCells : a_ghost;
+
+  this->fetchScratch(a_data, m_scratchIV, a_realm, a_phase, a_nComp, ghost);
+}
+
+void
+AmrMesh::clearScratch() const
+{
+  CH_TIME("AmrMesh::clearScratch");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::clearScratch" << endl;
+  }
+
+  // Holders that are still in use elsewhere are not released here, they are released once the last user lets go of them.
+  m_scratchCell.clear();
+  m_scratchFlux.clear();
+  m_scratchIV.clear();
+}
+
 void
 AmrMesh::allocate(EBAMRBool& a_data, const std::string a_realm, const int a_nComp, const int a_ghost) const
 {
@@ -935,13 +1001,54 @@ AmrMesh::regridAmr(const Vector<IntVectSet>& a_tags, const int a_lmin, const int
 
   CH_assert(a_lmin >= 0);
 
+  // Grids and other AmrMesh data are attributed to the Realm category, the Realms attribute their own memory.
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Realm, this);
+
   // TLDR: This is the version that reads boxes. AmrMesh makes the grids from the tags and load balances them
   //       by using the patch volume. Those grids are then sent to the various Realms.
 
   Vector<IntVectSet> tags = a_tags; // buildGrids destroys tags, so we actually have to copy them.
 
   this->buildGrids(tags, a_lmin, a_hardcap); // Build AMR grids -- the realm grids are defined with these grids.
-  this->defineRealms();                      // Define Realms with the new grids and redo the Realm stuff
+  this->regridRealmsBase(a_lmin);            // Define Realms with the new grids and redo the Realm stuff
+}
+
+void
+AmrMesh::regridAmr(const Vector<Vector<Box>>& a_tagBoxes, const int a_lmin, const int a_hardcap)
+{
+  CH_TIME("AmrMesh::regridAmr(Vector<Vector<Box>>, int, int)");
+  if (m_verbosity > 1) {
+    pout() << "AmrMesh::regridAmr(Vector<Vector<Box>>, int, int)" << endl;
+  }
+
+  CH_assert(a_lmin >= 0);
+
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Realm, this);
+
+  Vector<Vector<Box>> tagBoxes = a_tagBoxes;
+
+  this->buildGrids(tagBoxes, a_lmin, a_hardcap);
+  this->regridRealmsBase(a_lmin);
+}
+
+void
+AmrMesh::regridRealmsBase(const int a_lmin)
+{
+  CH_TIME("AmrMesh::regridRealmsBase(int)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::regridRealmsBase(int)" << endl;
+  }
+
+  this->defineRealms(); // Define Realms with the new grids and redo the Realm stuff
+
+  // Copiers between realms are no longer valid.
+  CH_assert(m_pendingCopies.empty());
+
+  m_realmCopiers.clear();
+  m_exchangeCopiers.clear();
+
+  // Scratch data lives on the old grids.
+  this->clearScratch();
 
   for (auto& r : m_realms) {
     r.second->regridBase(a_lmin);
@@ -961,12 +1068,13 @@ AmrMesh::regridOperators(const int a_lmin)
   }
 }
 
+template <typename T>
 void
-AmrMesh::buildGrids(Vector<IntVectSet>& a_tags, const int a_lmin, const int a_hardcap)
+AmrMesh::buildGrids(T& a_tags, const int a_lmin, const int a_hardcap)
 {
-  CH_TIME("AmrMesh::buildGrids(Vector<IntVectSet>, int, int)");
+  CH_TIME("AmrMesh::buildGrids(T, int, int)");
   if (m_verbosity > 2) {
-    pout() << "AmrMesh::buildGrids(Vector<IntVectSet>, int, int)" << endl;
+    pout() << "AmrMesh::buildGrids(T, int, int)" << endl;
   }
 
   // TLDR: a_lmin is the coarsest level that changes and a_hardcap is a hardcap for the maximum grid level that can
@@ -1001,30 +1109,8 @@ AmrMesh::buildGrids(Vector<IntVectSet>& a_tags, const int a_lmin, const int a_ha
       }
     }
 
-    // Berger-Rigoutsos grid generation
-    int newFinestLevel;
-
-    switch (m_gridGenerationMethod) {
-    case GridGenerationMethod::BergerRigoutsous: {
-      BRMeshRefine meshRefine(m_domains[0],
-                              m_refinementRatios,
-                              m_fillRatioBR,
-                              m_blockingFactor,
-                              m_bufferSizeBR,
-                              m_maxBoxSize);
-      newFinestLevel = meshRefine.regrid(newBoxes, a_tags, baseLevel, topLevel, oldBoxes);
-      break;
-    }
-    case GridGenerationMethod::Tiled: {
-      TiledMeshRefine meshRefine(m_domains[0], m_refinementRatios, m_blockingFactor * IntVect::Unit);
-      newFinestLevel = meshRefine.regrid(newBoxes, a_tags, baseLevel, topLevel, oldBoxes);
-      break;
-    }
-    default:
-      MayDay::Error(
-        "AmrMesh::buildGrids(Vector<IntVectSet>, int, int) - logic bust, regridding with unknown regrid algorithm");
-      break;
-    }
+    // Berger-Rigoutsos or tiled grid generation
+    const int newFinestLevel = this->generateBoxes(newBoxes, a_tags, baseLevel, topLevel, oldBoxes);
 
     // Identify the new finest grid level.
     m_finestLevel = Min(newFinestLevel, m_maxAmrDepth);       // Don't exceed m_maxAmrDepth
@@ -1076,6 +1162,81 @@ AmrMesh::buildGrids(Vector<IntVectSet>& a_tags, const int a_lmin, const int a_ha
   m_hasGrids = true;
 }
 
+int
+AmrMesh::generateBoxes(Vector<Vector<Box>>&       a_newBoxes,
+                       Vector<IntVectSet>&        a_tags,
+                       const int                  a_baseLevel,
+                       const int                  a_topLevel,
+                       const Vector<Vector<Box>>& a_oldBoxes) const
+{
+  CH_TIME("AmrMesh::generateBoxes(Vector<Vector<Box>>, Vector<IntVectSet>, int, int, Vector<Vector<Box>>)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::generateBoxes(Vector<Vector<Box>>, Vector<IntVectSet>, int, int, Vector<Vector<Box>>)" << endl;
+  }
+
+  int newFinestLevel = 0;
+
+  switch (m_gridGenerationMethod) {
+  case GridGenerationMethod::BergerRigoutsous: {
+    BRMeshRefine meshRefine(m_domains[0],
+                            m_refinementRatios,
+                            m_fillRatioBR,
+                            m_blockingFactor,
+                            m_bufferSizeBR,
+                            m_maxBoxSize);
+    newFinestLevel = meshRefine.regrid(a_newBoxes, a_tags, a_baseLevel, a_topLevel, a_oldBoxes);
+    break;
+  }
+  case GridGenerationMethod::Tiled: {
+    TiledMeshRefine meshRefine(m_domains[0], m_refinementRatios, m_blockingFactor * IntVect::Unit);
+    newFinestLevel = meshRefine.regrid(a_newBoxes, a_tags, a_baseLevel, a_topLevel, a_oldBoxes);
+    break;
+  }
+  default:
+    MayDay::Error("AmrMesh::generateBoxes - logic bust, regridding with unknown regrid algorithm");
+    break;
+  }
+
+  return newFinestLevel;
+}
+
+int
+AmrMesh::generateBoxes(Vector<Vector<Box>>&       a_newBoxes,
+                       Vector<Vector<Box>>&       a_tagBoxes,
+                       const int                  a_baseLevel,
+                       const int                  a_topLevel,
+                       const Vector<Vector<Box>>& a_oldBoxes) const
+{
+  CH_TIME("AmrMesh::generateBoxes(Vector<Vector<Box>>, Vector<Vector<Box>>, int, int, Vector<Vector<Box>>)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::generateBoxes(Vector<Vector<Box>>, Vector<Vector<Box>>, int, int, Vector<Vector<Box>>)" << endl;
+  }
+
+  int newFinestLevel = 0;
+
+  switch (m_gridGenerationMethod) {
+  case GridGenerationMethod::Tiled: {
+    TiledMeshRefine meshRefine(m_domains[0], m_refinementRatios, m_blockingFactor * IntVect::Unit);
+    newFinestLevel = meshRefine.regrid(a_newBoxes, a_tagBoxes, a_baseLevel, a_topLevel, a_oldBoxes);
+    break;
+  }
+  default: {
+    // The other grid generators need the tags as IntVectSets.
+    Vector<IntVectSet> tags(a_tagBoxes.size());
+    for (int lvl = 0; lvl < a_tagBoxes.size(); lvl++) {
+      for (int ibox = 0; ibox < a_tagBoxes[lvl].size(); ibox++) {
+        tags[lvl] |= a_tagBoxes[lvl][ibox];
+      }
+    }
+
+    newFinestLevel = this->generateBoxes(a_newBoxes, tags, a_baseLevel, a_topLevel, a_oldBoxes);
+    break;
+  }
+  }
+
+  return newFinestLevel;
+}
+
 void
 AmrMesh::computeGradient(LevelData<EBCellFAB>&       a_gradient,
                          const LevelData<EBCellFAB>& a_phi,
@@ -1564,6 +1725,42 @@ AmrMesh::interpGhost(LevelData<EBCellFAB>&       a_fineData,
   }
 }
 
+void
+AmrMesh::interpGhost(LevelData<EBCellFAB>&       a_fineData,
+                     const LevelData<EBCellFAB>& a_coarOld,
+                     const LevelData<EBCellFAB>& a_coarNew,
+                     const Real                  a_theta,
+                     const int                   a_fineLevel,
+                     const std::string           a_realm,
+                     const phase::which_phase    a_phase) const
+{
+  CH_TIME("AmrMesh::interpGhost(LD<EBCellFAB>, LD<EBCellFAB>, LD<EBCellFAB>, Real, int, string, phase::which_phase)");
+  if (m_verbosity > 3) {
+    pout() << "AmrMesh::interpGhost(LD<EBCellFAB>, LD<EBCellFAB>, LD<EBCellFAB>, Real, int, string, phase::which_phase)"
+           << endl;
+  }
+
+  if (!this->queryRealm(a_realm)) {
+    std::string str = "AmrMesh::interpGhost(LD<EBCellFAB>, LD<EBCellFAB>, LD<EBCellFAB>, Real, int, string, "
+                      "phase::which_phase) - could not find realm '" +
+                      a_realm + "'";
+    MayDay::Abort(str.c_str());
+  }
+
+  CH_assert(a_theta >= 0.0 && a_theta <= 1.0);
+
+  if (a_fineLevel > 0) {
+
+    const int      nComps = a_fineData.nComp();
+    const Interval interv = Interval(0, nComps - 1);
+
+    AggEBPWLFillPatch& fillpatch = *m_realms[a_realm]->getFillPatch(a_phase)[a_fineLevel];
+
+    // The fill patch interpolates linearly between the old and new coarse data, with the coarse data living at t = 0 and t = 1.
+    fillpatch.interpolate(a_fineData, a_coarOld, a_coarNew, 0.0, 1.0, a_theta, interv);
+  }
+}
+
 void
 AmrMesh::interpGhost(MFAMRCellData& a_data, const std::string a_realm) const
 {
@@ -2509,6 +2706,98 @@ AmrMesh::getGrids(const std::string a_realm) const
   return m_realms[a_realm]->getGrids();
 }
 
+const Copier&
+AmrMesh::getCopier(const std::string a_srcRealm,
+                   const std::string a_dstRealm,
+                   const int         a_level,
+                   const IntVect&    a_dstGhost) const
+{
+  CH_TIME("AmrMesh::getCopier(string, string, int, IntVect)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::getCopier(string, string, int, IntVect)" << endl;
+  }
+
+  return this->getIdleCopier(a_srcRealm, a_dstRealm, a_level, a_dstGhost)->m_copier;
+}
+
+std::shared_ptr<AmrMesh::RealmCopier>
+AmrMesh::getIdleCopier(const std::string a_srcRealm,
+                       const std::string a_dstRealm,
+                       const int         a_level,
+                       const IntVect&    a_dstGhost) const
+{
+  CH_TIME("AmrMesh::getIdleCopier(string, string, int, IntVect)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::getIdleCopier(string, string, int, IntVect)" << endl;
+  }
+
+  CH_assert(a_level >= 0);
+  CH_assert(a_level <= m_finestLevel);
+
+  const DisjointBoxLayout& srcGrids = this->getGrids(a_srcRealm)[a_level];
+  const DisjointBoxLayout& dstGrids = this->getGrids(a_dstRealm)[a_level];
+
+  std::array<int, SpaceDim> ghost;
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    ghost[dir] = a_dstGhost[dir];
+  }
+
+  std::vector<std::shared_ptr<RealmCopier>>& pool = m_realmCopiers[std::make_tuple(a_srcRealm, a_dstRealm, a_level, ghost)];
+
+  // Use the first copier that is not reserved by a pending transfer, or add a new one if they all are.
+  std::shared_ptr<RealmCopier> cached;
+  for (const auto& copier : pool) {
+    if (!(copier->m_inFlight)) {
+      cached = copier;
+
+      break;
+    }
+  }
+
+  if (!cached) {
+    cached = std::make_shared<RealmCopier>();
+
+    pool.emplace_back(cached);
+  }
+
+  // Rebuild if this is a new entry or if the grids changed without going through regridAmr/regridRealm.
+  if (!(cached->m_srcGrids == srcGrids) || !(cached->m_dstGrids == dstGrids)) {
+    cached->m_srcGrids = srcGrids;
+    cached->m_dstGrids = dstGrids;
+    cached->m_copier.define(srcGrids, dstGrids, m_domains[a_level], a_dstGhost);
+  }
+
+  return cached;
+}
+
+const Copier&
+AmrMesh::getExchangeCopier(const std::string a_realm, const int a_level, const IntVect& a_ghost) const
+{
+  CH_TIME("AmrMesh::getExchangeCopier(string, int, IntVect)");
+  if (m_verbosity > 5) {
+    pout() << "AmrMesh::getExchangeCopier(string, int, IntVect)" << endl;
+  }
+
+  CH_assert(a_level >= 0);
+  CH_assert(a_level <= m_finestLevel);
+
+  const DisjointBoxLayout& grids = this->getGrids(a_realm)[a_level];
+
+  std::array<int, SpaceDim> ghost;
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    ghost[dir] = a_ghost[dir];
+  }
+
+  RealmCopier& cached = m_exchangeCopiers[std::make_tuple(a_realm, a_level, ghost)];
+
+  if (!(cached.m_srcGrids == grids)) {
+    cached.m_srcGrids = grids;
+    cached.m_copier.exchangeDefine(grids, a_ghost);
+  }
+
+  return cached.m_copier;
+}
+
 const Vector<EBISLayout>&
 AmrMesh::getEBISLayout(const std::string a_realm, const phase::which_phase a_phase) const
 {
@@ -3020,6 +3309,43 @@ AmrMesh::regridRealm(const std::string          a_realm,
                             m_multifluidIndexSpace);
 
   m_realms[a_realm]->regridBase(a_lmin);
+
+  // Copiers to/from this realm are no longer valid.
+  CH_assert(m_pendingCopies.empty());
+
+  for (auto it = m_realmCopiers.begin(); it != m_realmCopiers.end();) {
+    if (std::get<0>(it->first) == a_realm || std::get<1>(it->first) == a_realm) {
+      it = m_realmCopiers.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  for (auto it = m_exchangeCopiers.begin(); it != m_exchangeCopiers.end();) {
+    if (std::get<0>(it->first) == a_realm) {
+      it = m_exchangeCopiers.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  // Scratch data on this realm lives on the old grids.
+  auto clearRealmScratch = [&a_realm](auto& pool) {
+    for (auto it = pool.begin(); it != pool.end();) {
+      if (std::get<0>(it->first) == a_realm) {
+        it = pool.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  };
+
+  clearRealmScratch(m_scratchCell);
+  clearRealmScratch(m_scratchFlux);
+  clearRealmScratch(m_scratchIV);
 }
 
 std::vector<std::string>
@@ -16,6 +16,7 @@
 // Our includes
 #include <CD_Realm.H>
 #include <CD_BoxLoops.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 const std::string Realm::Primal = "primal";
@@ -35,7 +36,7 @@ Realm::Realm()
   m_realms.emplace(phase::solid, RefCountedPtr<PhaseRealm>(new PhaseRealm()));
 }
 
-Realm::~Realm() {}
+Realm::~Realm() { MemoryReport::releaseMemory(this); }
 
 void
 Realm::define(const Vector<DisjointBoxLayout>&                          a_grids,
@@ -133,6 +134,8 @@ Realm::regridBase(const int a_lmin)
     pout() << "Realm::regridBase" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Realm, this);
+
   for (auto& r : m_realms) {
     r.second->regridBase(a_lmin);
   }
@@ -148,6 +151,8 @@ Realm::regridOperators(const int a_lmin)
     pout() << "Realm::regridOperators" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Operators, this);
+
   for (auto& r : m_realms) {
     r.second->regridOperators(a_lmin);
   }
@@ -9,8 +9,13 @@
   @author Robert Marskar
 */
 
+// Std includes
+#include <algorithm>
+#include <cstdint>
+
 // Chombo includes
 #include <CH_Timer.H>
+#include <BoxIterator.H>
 
 // Our includes
 #include <CD_TiledMeshRefine.H>
@@ -65,7 +70,24 @@ TiledMeshRefine::regrid(Vector<Vector<Box>>&       a_newGrids,
                         const int                  a_topLevel,
                         const Vector<Vector<Box>>& a_oldGrids) const
 {
-  CH_TIME("TiledMeshRefine::regrid");
+  CH_TIME("TiledMeshRefine::regrid(Vector<IntVectSet>)");
+
+  Vector<Vector<Box>> tagBoxes(a_tags.size());
+  for (int lvl = 0; lvl < a_tags.size(); lvl++) {
+    tagBoxes[lvl] = a_tags[lvl].boxes();
+  }
+
+  return this->regrid(a_newGrids, tagBoxes, a_baseLevel, a_topLevel, a_oldGrids);
+}
+
+int
+TiledMeshRefine::regrid(Vector<Vector<Box>>&       a_newGrids,
+                        const Vector<Vector<Box>>& a_tags,
+                        const int                  a_baseLevel,
+                        const int                  a_topLevel,
+                        const Vector<Vector<Box>>& a_oldGrids) const
+{
+  CH_TIME("TiledMeshRefine::regrid(Vector<Vector<Box>>)");
 
   // CH_assert(a_topLevel >= 0 );
   // CH_assert(a_baseLevel < (a_topLevel+1) && a_baseLevel >= 0 );
@@ -84,8 +106,10 @@ TiledMeshRefine::regrid(Vector<Vector<Box>>&       a_newGrids,
   int myTopLevel = 0;
 
   for (int lvl = 0; lvl < a_tags.size(); lvl++) {
-    if (!a_tags[lvl].isEmpty()) {
-      myTopLevel = lvl;
+    for (int ibox = 0; ibox < a_tags[lvl].size(); ibox++) {
+      if (!a_tags[lvl][ibox].isEmpty()) {
+        myTopLevel = lvl;
+      }
     }
   }
 
@@ -101,7 +125,7 @@ TiledMeshRefine::regrid(Vector<Vector<Box>>&       a_newGrids,
     newFinestLevel = 1 + topLevel;
 
     // Extra level of empty tiles so we can use makeLevelTiles for all levels
-    Vector<IntVectSet> tiles(2 + newFinestLevel, IntVectSet());
+    std::vector<std::vector<long long>> tiles(2 + newFinestLevel);
 
     // Make tiles on all levels above a_baseLevel
     for (int lvl = newFinestLevel; lvl > a_baseLevel; lvl--) {
@@ -139,116 +163,222 @@ TiledMeshRefine::regrid(Vector<Vector<Box>>&       a_newGrids,
   return newFinestLevel;
 }
 
+IntVect
+TiledMeshRefine::getNumTiles(const ProblemDomain& a_levelDomain) const
+{
+  return a_levelDomain.domainBox().size() / m_tileSize;
+}
+
+long long
+TiledMeshRefine::tileToID(const IntVect& a_tile, const IntVect& a_numTiles) const
+{
+  long long id = 0;
+  for (int dir = SpaceDim - 1; dir >= 0; dir--) {
+    id = id * a_numTiles[dir] + a_tile[dir];
+  }
+
+  return id;
+}
+
+IntVect
+TiledMeshRefine::idToTile(long long a_tileID, const IntVect& a_numTiles) const
+{
+  IntVect tile;
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    tile[dir] = a_tileID % a_numTiles[dir];
+    a_tileID /= a_numTiles[dir];
+  }
+
+  return tile;
+}
+
 void
-TiledMeshRefine::makeLevelTiles(IntVectSet&          a_levelTiles,
-                                const IntVectSet&    a_fineLevelTiles,
-                                const IntVectSet&    a_coarLevelTags,
-                                const ProblemDomain& a_levelDomain,
-                                const int            a_refFine,
-                                const int            a_refCoar) const
+TiledMeshRefine::makeLocalTiles(std::vector<long long>& a_localTiles,
+                                const Vector<Box>&      a_coarLevelTags,
+                                const ProblemDomain&    a_levelDomain,
+                                const int               a_refCoar) const
 {
-  CH_TIME("TiledMeshRefine::makeLevelTiles");
+  CH_TIME("TiledMeshRefine::makeLocalTiles");
 
-  // Lo/Hi corners and number of tiles in each direction
+  a_localTiles.resize(0);
 
-  const IntVect numLevelTiles = a_levelDomain.domainBox().size() / m_tileSize;
-  const Box     levelTileBox(IntVect::Zero, numLevelTiles - 1);
+  const IntVect numLevelTiles = this->getNumTiles(a_levelDomain);
+  const IntVect coarTileSize  = m_tileSize / a_refCoar;
 
-  // 1. Generate tiles on this level from tags on the coarser level
   Box coarBox = a_levelDomain.domainBox();
   coarBox.coarsen(a_refCoar);
-  const IntVect probLo       = coarBox.smallEnd();
-  IntVectSet    myLevelTiles = IntVectSet();
 
-  for (IVSIterator ivsIt(a_coarLevelTags); ivsIt.ok(); ++ivsIt) {
-    const IntVect iv = ivsIt();
+  const IntVect probLo = coarBox.smallEnd();
 
-    IntVect curTile;
-    for (int dir = 0; dir < SpaceDim; dir++) {
-      curTile[dir] = (iv[dir] - probLo[dir]) / (m_tileSize[dir] / a_refCoar);
-    }
-    if (levelTileBox.contains(curTile)) {
-      myLevelTiles |= curTile;
+  // Go through the tags box-by-box rather than cell-by-cell, and flag all tiles that the boxes touch.
+  for (int ibox = 0; ibox < a_coarLevelTags.size(); ibox++) {
+    const Box tagBox = a_coarLevelTags[ibox] & coarBox;
+
+    if (!tagBox.isEmpty()) {
+      const Box tileBox((tagBox.smallEnd() - probLo) / coarTileSize, (tagBox.bigEnd() - probLo) / coarTileSize);
+
+      for (BoxIterator bit(tileBox); bit.ok(); ++bit) {
+        a_localTiles.emplace_back(this->tileToID(bit(), numLevelTiles));
+      }
     }
   }
 
-  // 2. If the domain is periodic, add symmetry tiles
-  for (int dir = 0; dir < SpaceDim; dir++) {
-    if (a_levelDomain.isPeriodic(dir)) {
-      IntVectSet periodicTiles;
-      for (IVSIterator ivsIt(myLevelTiles); ivsIt.ok(); ++ivsIt) {
-        const IntVect tile = ivsIt();
-
-        IntVect mirrorTile = tile;
-        if (tile[dir] == 0) {
-          mirrorTile[dir] = numLevelTiles[dir];
-          periodicTiles |= mirrorTile;
-        }
-        else if (tile[dir] == numLevelTiles[dir]) {
-          mirrorTile[dir] = 0;
-          periodicTiles |= mirrorTile;
+  std::sort(a_localTiles.begin(), a_localTiles.end());
+  a_localTiles.erase(std::unique(a_localTiles.begin(), a_localTiles.end()), a_localTiles.end());
+}
+
+void
+TiledMeshRefine::gatherTiles(std::vector<long long>& a_tiles, const long long a_numTiles) const
+{
+  CH_TIME("TiledMeshRefine::gatherTiles");
+
+#ifdef CH_MPI
+  long long numLocalTiles  = a_tiles.size();
+  long long numGlobalTiles = 0;
+
+  MPI_Allreduce(&numLocalTiles, &numGlobalTiles, 1, MPI_LONG_LONG, MPI_SUM, Chombo_MPI::comm);
+
+  // Gathering the tile IDs costs one word per tagged tile on each rank while the bit set costs one bit per tile on the
+  // level, so use the bit set when the tags are dense.
+  const long long numWords = (a_numTiles + 63) / 64;
+
+  if (numGlobalTiles == 0) {
+    return;
+  }
+  else if (numWords <= numGlobalTiles) {
+    std::vector<uint64_t> bits(numWords, 0);
+
+    for (const auto& id : a_tiles) {
+      bits[id / 64] |= uint64_t(1) << (id % 64);
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, bits.data(), int(numWords), MPI_UINT64_T, MPI_BOR, Chombo_MPI::comm);
+
+    // Unpack the bit set. The tiles come out sorted.
+    a_tiles.resize(0);
+
+    for (long long iword = 0; iword < numWords; iword++) {
+      uint64_t word = bits[iword];
+
+      for (int ibit = 0; word != 0; ibit++, word >>= 1) {
+        if (word & 1) {
+          a_tiles.emplace_back(64 * iword + ibit);
         }
       }
-      myLevelTiles |= periodicTiles;
     }
   }
+  else {
+    const int numRanks    = numProc();
+    const int mySendCount = a_tiles.size();
 
-  // 3. Gather tiles globally
-#ifdef CH_MPI
-  const int          destProc = uniqueProc(SerialTask::compute);
-  Vector<IntVectSet> allTaggedTiles;
-  gather(allTaggedTiles, myLevelTiles, destProc);
-  if (procID() == destProc) {
-    a_levelTiles.makeEmpty();
-    for (int i = 0; i < allTaggedTiles.size(); i++) {
-      a_levelTiles |= allTaggedTiles[i];
+    std::vector<int> sendCounts(numRanks);
+    std::vector<int> offsets(numRanks, 0);
+
+    MPI_Allgather(&mySendCount, 1, MPI_INT, sendCounts.data(), 1, MPI_INT, Chombo_MPI::comm);
+
+    for (int i = 0; i < numRanks - 1; i++) {
+      offsets[i + 1] = offsets[i] + sendCounts[i];
     }
+
+    std::vector<long long> allTiles(offsets[numRanks - 1] + sendCounts[numRanks - 1]);
+
+    MPI_Allgatherv(a_tiles.data(),
+                   mySendCount,
+                   MPI_LONG_LONG,
+                   allTiles.data(),
+                   sendCounts.data(),
+                   offsets.data(),
+                   MPI_LONG_LONG,
+                   Chombo_MPI::comm);
+
+    std::sort(allTiles.begin(), allTiles.end());
+    allTiles.erase(std::unique(allTiles.begin(), allTiles.end()), allTiles.end());
+
+    a_tiles.swap(allTiles);
   }
-  broadcast(a_levelTiles, destProc);
-#else
-  a_levelTiles = myLevelTiles;
 #endif
+}
 
-  // 4. Add finer level tiles to this level to ensure proper nesting. We do this by adding all the neighboring tiles to a tile
-  //    on the finer level, coarsening all those tiles and adding them to this level
-  if (a_fineLevelTiles.numPts() > 0) {
-    //    MayDay::Abort("wtf");
-    Box fineTileBox = levelTileBox;
-    fineTileBox.refine(a_refFine);
+void
+TiledMeshRefine::makeLevelTiles(std::vector<long long>&       a_levelTiles,
+                                const std::vector<long long>& a_fineLevelTiles,
+                                const Vector<Box>&            a_coarLevelTags,
+                                const ProblemDomain&          a_levelDomain,
+                                const int                     a_refFine,
+                                const int                     a_refCoar) const
+{
+  CH_TIME("TiledMeshRefine::makeLevelTiles");
 
-    for (IVSIterator ivsIt(a_fineLevelTiles); ivsIt.ok(); ++ivsIt) {
-      const IntVect iv = ivsIt();
+  const IntVect numLevelTiles = this->getNumTiles(a_levelDomain);
 
-      // Grow tiles and restrict to fine domain
-      Box box(iv, iv);
-      box.grow(1);
-      IntVectSet grownFineLevelTiles(box);
-      grownFineLevelTiles &= fineTileBox;
+  // 1. Generate tiles on this level from tags on the coarser level. Only the tags on this rank are used here.
+  this->makeLocalTiles(a_levelTiles, a_coarLevelTags, a_levelDomain, a_refCoar);
 
-      a_levelTiles |= coarsen(grownFineLevelTiles, a_refFine);
-    }
+  // 2. Gather tiles globally
+  long long numTiles = 1;
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    numTiles *= numLevelTiles[dir];
   }
 
-  // 5. Restrict tiles to problem domains. Shouldn't be necessary
-  //  a_levelTiles &= levelTileBox;
+  this->gatherTiles(a_levelTiles, numTiles);
+
+  // 3. Add finer level tiles to this level to ensure proper nesting. We do this by adding all the neighboring tiles to a tile
+  //    on the finer level, coarsening all those tiles and adding them to this level. If the domain is periodic, the neighboring
+  //    tiles are wrapped around the domain.
+  if (a_fineLevelTiles.size() > 0) {
+    const IntVect numFineTiles = numLevelTiles * a_refFine;
+    const Box     neighborhood(-IntVect::Unit, IntVect::Unit);
+
+    std::vector<long long> nestingTiles;
+    nestingTiles.reserve(a_fineLevelTiles.size());
+
+    for (const auto& fineID : a_fineLevelTiles) {
+      const IntVect fineTile = this->idToTile(fineID, numFineTiles);
+
+      for (BoxIterator bit(neighborhood); bit.ok(); ++bit) {
+        IntVect neighborTile = fineTile + bit();
+
+        bool insideDomain = true;
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          if (neighborTile[dir] < 0 || neighborTile[dir] >= numFineTiles[dir]) {
+            if (a_levelDomain.isPeriodic(dir)) {
+              neighborTile[dir] = (neighborTile[dir] + numFineTiles[dir]) % numFineTiles[dir];
+            }
+            else {
+              insideDomain = false;
+            }
+          }
+        }
+
+        if (insideDomain) {
+          nestingTiles.emplace_back(this->tileToID(neighborTile / a_refFine, numLevelTiles));
+        }
+      }
+    }
+
+    a_levelTiles.insert(a_levelTiles.end(), nestingTiles.begin(), nestingTiles.end());
+
+    std::sort(a_levelTiles.begin(), a_levelTiles.end());
+    a_levelTiles.erase(std::unique(a_levelTiles.begin(), a_levelTiles.end()), a_levelTiles.end());
+  }
 }
 
 void
-TiledMeshRefine::makeBoxesFromTiles(Vector<Box>&         a_levelBoxes,
-                                    const IntVectSet&    a_levelTiles,
-                                    const ProblemDomain& a_levelDomain) const
+TiledMeshRefine::makeBoxesFromTiles(Vector<Box>&                  a_levelBoxes,
+                                    const std::vector<long long>& a_levelTiles,
+                                    const ProblemDomain&          a_levelDomain) const
 {
   CH_TIME("TiledMeshRefine::makeBoxesFromTiles");
 
   a_levelBoxes.resize(0);
 
-  const IntVect probLo = a_levelDomain.domainBox().smallEnd();
-  const IntVect probHi = a_levelDomain.domainBox().bigEnd();
+  const IntVect probLo        = a_levelDomain.domainBox().smallEnd();
+  const IntVect numLevelTiles = this->getNumTiles(a_levelDomain);
 
-  for (IVSIterator ivsIt(a_levelTiles); ivsIt.ok(); ++ivsIt) {
-    const IntVect iv = ivsIt();
+  for (const auto& id : a_levelTiles) {
+    const IntVect tile = this->idToTile(id, numLevelTiles);
 
-    const IntVect lo = probLo + iv * m_tileSize;
+    const IntVect lo = probLo + tile * m_tileSize;
     const IntVect hi = lo + m_tileSize - IntVect::Unit;
 
     a_levelBoxes.push_back(Box(lo, hi));
@@ -0,0 +1,431 @@
+/* chombo-discharge
+ * Copyright © 2021 SINTEF Energy Research.
+ * Please refer to Copyright.txt and LICENSE in the chombo-discharge root directory.
+ */
+
+/*!
+  @file   CD_TagMask.cpp
+  @brief  Implementation of CD_TagMask.H
+  @author Robert Marskar
+*/
+
+// Std includes
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <map>
+
+// Chombo includes
+#include <CH_Timer.H>
+#include <BoxIterator.H>
+
+// Our includes
+#include <CD_TagMask.H>
+#include <CD_NamespaceHeader.H>
+
+TagMask::TagMask()
+{
+  m_wordsPerRow = 0;
+  m_numRows     = 0;
+}
+
+TagMask::TagMask(const Box& a_box) { this->define(a_box); }
+
+TagMask::TagMask(const DenseIntVectSet& a_tags)
+{
+  CH_TIME("TagMask::TagMask(DenseIntVectSet)");
+
+  this->define(a_tags.box());
+
+  for (DenseIntVectSetIterator ivsIt(a_tags); ivsIt.ok(); ++ivsIt) {
+    this->setTag(ivsIt());
+  }
+}
+
+TagMask::~TagMask() {}
+
+void
+TagMask::define(const Box& a_box)
+{
+  m_box         = a_box;
+  m_wordsPerRow = 0;
+  m_numRows     = 0;
+
+  if (!m_box.isEmpty()) {
+    m_wordsPerRow = (m_box.size(0) + 63) / 64;
+    m_numRows     = 1;
+
+    for (int dir = 1; dir < SpaceDim; dir++) {
+      m_numRows *= m_box.size(dir);
+    }
+  }
+
+  m_bits.assign(m_wordsPerRow * m_numRows, 0);
+}
+
+const Box&
+TagMask::box() const
+{
+  return m_box;
+}
+
+int
+TagMask::rowIndex(const IntVect& a_iv) const
+{
+  int r = 0;
+  for (int dir = SpaceDim - 1; dir > 0; dir--) {
+    r = r * m_box.size(dir) + (a_iv[dir] - m_box.smallEnd(dir));
+  }
+
+  return r;
+}
+
+IntVect
+TagMask::rowStart(int a_row) const
+{
+  IntVect iv = m_box.smallEnd();
+  for (int dir = 1; dir < SpaceDim; dir++) {
+    iv[dir] += a_row % m_box.size(dir);
+    a_row /= m_box.size(dir);
+  }
+
+  return iv;
+}
+
+int
+TagMask::rowStride(const int a_dir) const
+{
+  CH_assert(a_dir > 0);
+
+  int stride = 1;
+  for (int dir = 1; dir < a_dir; dir++) {
+    stride *= m_box.size(dir);
+  }
+
+  return stride;
+}
+
+uint64_t*
+TagMask::row(const int a_row)
+{
+  return m_bits.data() + a_row * m_wordsPerRow;
+}
+
+const uint64_t*
+TagMask::row(const int a_row) const
+{
+  return m_bits.data() + a_row * m_wordsPerRow;
+}
+
+void
+TagMask::clearPadding()
+{
+  const int numBits = m_box.size(0) % 64;
+
+  if (numBits > 0) {
+    const uint64_t mask = (uint64_t(1) << numBits) - 1;
+
+    for (int r = 0; r < m_numRows; r++) {
+      this->row(r)[m_wordsPerRow - 1] &= mask;
+    }
+  }
+}
+
+void
+TagMask::setTag(const IntVect& a_iv)
+{
+  CH_assert(m_box.contains(a_iv));
+
+  const int i = a_iv[0] - m_box.smallEnd(0);
+
+  this->row(this->rowIndex(a_iv))[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+bool
+TagMask::isTagged(const IntVect& a_iv) const
+{
+  CH_assert(m_box.contains(a_iv));
+
+  const int i = a_iv[0] - m_box.smallEnd(0);
+
+  return (this->row(this->rowIndex(a_iv))[i / 64] >> (i % 64)) & 1;
+}
+
+bool
+TagMask::isEmpty() const
+{
+  for (const auto& word : m_bits) {
+    if (word != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+long long
+TagMask::numTags() const
+{
+  long long num = 0;
+  for (const auto& word : m_bits) {
+    num += std::bitset<64>(word).count();
+  }
+
+  return num;
+}
+
+TagMask&
+TagMask::operator|=(const TagMask& a_other)
+{
+  CH_TIME("TagMask::operator|=");
+
+  if (m_box == a_other.m_box) {
+    for (int i = 0; i < m_bits.size(); i++) {
+      m_bits[i] |= a_other.m_bits[i];
+    }
+  }
+  else {
+    const Box overlap = m_box & a_other.m_box;
+
+    if (!overlap.isEmpty()) {
+      const int numBits = overlap.size(0);
+      const int srcLo   = overlap.smallEnd(0) - a_other.m_box.smallEnd(0);
+      const int dstLo   = overlap.smallEnd(0) - m_box.smallEnd(0);
+
+      // Iterate over the rows in the overlap and copy the bits in chunks of up to 64 bits, which may straddle two words in
+      // both the source and destination rows.
+      Box rows = overlap;
+      rows.setBig(0, overlap.smallEnd(0));
+
+      for (BoxIterator bit(rows); bit.ok(); ++bit) {
+        const uint64_t* src = a_other.row(a_other.rowIndex(bit()));
+        uint64_t*       dst = this->row(this->rowIndex(bit()));
+
+        for (int k = 0; k < numBits; k += 64) {
+          const int len = std::min(64, numBits - k);
+
+          const int srcWord = (srcLo + k) / 64;
+          const int srcBit  = (srcLo + k) % 64;
+
+          uint64_t chunk = src[srcWord] >> srcBit;
+          if (srcBit > 0 && srcBit + len > 64) {
+            chunk |= src[srcWord + 1] << (64 - srcBit);
+          }
+          if (len < 64) {
+            chunk &= (uint64_t(1) << len) - 1;
+          }
+
+          const int dstWord = (dstLo + k) / 64;
+          const int dstBit  = (dstLo + k) % 64;
+
+          dst[dstWord] |= chunk << dstBit;
+          if (dstBit > 0 && dstBit + len > 64) {
+            dst[dstWord + 1] |= chunk >> (64 - dstBit);
+          }
+        }
+      }
+    }
+  }
+
+  return *this;
+}
+
+void
+TagMask::grow(const int a_numCells)
+{
+  CH_TIME("TagMask::grow");
+
+  if (a_numCells <= 0 || m_box.isEmpty()) {
+    return;
+  }
+
+  Box grownBox = m_box;
+  grownBox.grow(a_numCells);
+
+  TagMask grown(grownBox);
+  grown |= *this;
+
+  // Grow along x by shifting whole rows one bit up and down.
+  std::vector<uint64_t> tmp(grown.m_wordsPerRow);
+
+  for (int step = 0; step < a_numCells; step++) {
+    for (int r = 0; r < grown.m_numRows; r++) {
+      uint64_t* words = grown.row(r);
+
+      for (int w = 0; w < grown.m_wordsPerRow; w++) {
+        tmp[w] = words[w] | (words[w] << 1) | (words[w] >> 1);
+
+        if (w > 0) {
+          tmp[w] |= words[w - 1] >> 63;
+        }
+        if (w < grown.m_wordsPerRow - 1) {
+          tmp[w] |= words[w + 1] << 63;
+        }
+      }
+
+      std::copy(tmp.begin(), tmp.end(), words);
+    }
+
+    // Shifting up may have moved bits into the padding, and they would be shifted back down in the next step.
+    grown.clearPadding();
+  }
+
+  // Grow along the other directions by adding neighboring rows.
+  for (int dir = 1; dir < SpaceDim; dir++) {
+    const int stride  = grown.rowStride(dir);
+    const int numRows = grown.m_box.size(dir);
+
+    for (int step = 0; step < a_numCells; step++) {
+      const std::vector<uint64_t> bits = grown.m_bits;
+
+      for (int r = 0; r < grown.m_numRows; r++) {
+        const int i = (r / stride) % numRows;
+
+        uint64_t* dst = grown.row(r);
+
+        if (i > 0) {
+          const uint64_t* src = bits.data() + (r - stride) * grown.m_wordsPerRow;
+          for (int w = 0; w < grown.m_wordsPerRow; w++) {
+            dst[w] |= src[w];
+          }
+        }
+        if (i < numRows - 1) {
+          const uint64_t* src = bits.data() + (r + stride) * grown.m_wordsPerRow;
+          for (int w = 0; w < grown.m_wordsPerRow; w++) {
+            dst[w] |= src[w];
+          }
+        }
+      }
+    }
+  }
+
+  *this = std::move(grown);
+}
+
+void
+TagMask::coarsen(const int a_refRat)
+{
+  CH_TIME("TagMask::coarsen");
+
+  CH_assert(a_refRat > 0);
+
+  if (a_refRat == 1 || m_box.isEmpty()) {
+    return;
+  }
+
+  Box coarBox = m_box;
+  coarBox.coarsen(a_refRat);
+
+  TagMask coarMask(coarBox);
+
+  // Only visit the words that have tags in them.
+  for (int r = 0; r < m_numRows; r++) {
+    const uint64_t* words = this->row(r);
+    const IntVect   start = this->rowStart(r);
+
+    for (int w = 0; w < m_wordsPerRow; w++) {
+      if (words[w] != 0) {
+        for (int b = 0; b < 64; b++) {
+          if ((words[w] >> b) & 1) {
+            IntVect iv = start;
+            iv[0] += 64 * w + b;
+
+            iv.coarsen(a_refRat);
+
+            coarMask.setTag(iv);
+          }
+        }
+      }
+    }
+  }
+
+  *this = std::move(coarMask);
+}
+
+void
+TagMask::getBoxes(Vector<Box>& a_boxes) const
+{
+  CH_TIME("TagMask::getBoxes");
+
+  // Get the runs of tags along x in each row.
+  std::vector<Box> boxes;
+
+  for (int r = 0; r < m_numRows; r++) {
+    const uint64_t* words = this->row(r);
+    const IntVect   start = this->rowStart(r);
+
+    int runStart = -1;
+    for (int w = 0; w < m_wordsPerRow; w++) {
+      const uint64_t word = words[w];
+
+      if (word == 0 && runStart < 0) {
+        continue;
+      }
+      else if (word == ~uint64_t(0) && runStart >= 0) {
+        continue;
+      }
+
+      for (int b = 0; b < 64; b++) {
+        const bool isTagged = (word >> b) & 1;
+        const int  i        = 64 * w + b;
+
+        if (isTagged && runStart < 0) {
+          runStart = i;
+        }
+        else if (!isTagged && runStart >= 0) {
+          IntVect lo = start;
+          IntVect hi = start;
+
+          lo[0] += runStart;
+          hi[0] += i - 1;
+
+          boxes.emplace_back(lo, hi);
+
+          runStart = -1;
+        }
+      }
+    }
+
+    if (runStart >= 0) {
+      IntVect lo = start;
+      IntVect hi = start;
+
+      lo[0] += runStart;
+      hi[0] = m_box.bigEnd(0);
+
+      boxes.emplace_back(lo, hi);
+    }
+  }
+
+  // Merge boxes that are identical except for being neighbors along dir. The rows were visited with y varying fastest so that
+  // boxes that can be merged always appear in increasing order along dir.
+  for (int dir = 1; dir < SpaceDim; dir++) {
+    std::vector<Box>                            merged;
+    std::map<std::array<int, 2 * SpaceDim>, int> open;
+
+    for (const auto& box : boxes) {
+      std::array<int, 2 * SpaceDim> key;
+      for (int d = 0; d < SpaceDim; d++) {
+        key[d]            = (d == dir) ? 0 : box.smallEnd(d);
+        key[SpaceDim + d] = (d == dir) ? 0 : box.bigEnd(d);
+      }
+
+      auto it = open.find(key);
+      if (it != open.end() && merged[it->second].bigEnd(dir) == box.smallEnd(dir) - 1) {
+        merged[it->second].setBig(dir, box.bigEnd(dir));
+      }
+      else {
+        open[key] = merged.size();
+        merged.emplace_back(box);
+      }
+    }
+
+    boxes.swap(merged);
+  }
+
+  for (const auto& box : boxes) {
+    a_boxes.push_back(box);
+  }
+}
+
+#include <CD_NamespaceFooter.H>
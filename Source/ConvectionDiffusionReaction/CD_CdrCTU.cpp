@@ -67,17 +67,17 @@ CdrCTU::parseRuntimeOptions()
 }
 
 Real
-CdrCTU::computeAdvectionDt()
+CdrCTU::computeLevelAdvectionDt(const int a_lvl)
 {
-  CH_TIME("CdrCTU::computeAdvectionDt()");
+  CH_TIME("CdrCTU::computeLevelAdvectionDt(int)");
   if (m_verbosity > 5) {
-    pout() << m_name + "::computeAdvectionDt()" << endl;
+    pout() << m_name + "::computeLevelAdvectionDt(int)" << endl;
   }
 
   Real minDt = std::numeric_limits<Real>::max();
 
   if (!m_useCTU) {
-    minDt = CdrMultigrid::computeAdvectionDt();
+    minDt = CdrMultigrid::computeLevelAdvectionDt(a_lvl);
   }
   else {
 
@@ -87,55 +87,50 @@ CdrCTU::computeAdvectionDt()
     //       Bell, Colella, Glaz, J. Comp. Phys 85 (257), 1989
     //       Minion, J. Comp. Phys 123 (435), 1996
     if (m_isMobile) {
-      for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-        const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[lvl];
-        const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
-        const Real               dx    = m_amr->getDx()[lvl];
-
-        for (DataIterator dit(dbl); dit.ok(); ++dit) {
-          const Box        cellBox = dbl[dit()];
-          const EBCellFAB& velo    = (*m_cellVelocity[lvl])[dit()];
-          const EBISBox&   ebisBox = ebisl[dit()];
-
-          VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
-
-          // Regular grid data.
-          const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
-
-          // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
-          auto regularKernel = [&](const IntVect& iv) -> void {
-            Real velMax = 0.0;
-            if (ebisBox.isRegular(iv)) {
-              for (int dir = 0; dir < SpaceDim; dir++) {
-                velMax = std::max(velMax, std::abs(veloReg(iv, dir)));
-              }
-            }
+      const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[a_lvl];
+      const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
+      const Real               dx    = m_amr->getDx()[a_lvl];
 
-            if (velMax > 0.0) {
-              minDt = std::min(dx / velMax, minDt);
-            }
-          };
+      for (DataIterator dit(dbl); dit.ok(); ++dit) {
+        const Box        cellBox = dbl[dit()];
+        const EBCellFAB& velo    = (*m_cellVelocity[a_lvl])[dit()];
+        const EBISBox&   ebisBox = ebisl[dit()];
+
+        VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[dit()];
+
+        // Regular grid data.
+        const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
 
-          // Same kernel, but for cut-cells.
-          auto irregularKernel = [&](const VolIndex& vof) -> void {
-            Real velMax = 0.0;
+        // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
+        auto regularKernel = [&](const IntVect& iv) -> void {
+          Real velMax = 0.0;
+          if (ebisBox.isRegular(iv)) {
             for (int dir = 0; dir < SpaceDim; dir++) {
-              velMax = std::max(velMax, std::abs(velo(vof, dir)));
+              velMax = std::max(velMax, std::abs(veloReg(iv, dir)));
             }
+          }
 
-            if (velMax > 0.0) {
-              minDt = std::min(dx / velMax, minDt);
-            }
-          };
+          if (velMax > 0.0) {
+            minDt = std::min(dx / velMax, minDt);
+          }
+        };
 
-          // Execute the kernels.
-          BoxLoops::loop(cellBox, regularKernel);
-          BoxLoops::loop(vofit, irregularKernel);
-        }
-      }
+        // Same kernel, but for cut-cells.
+        auto irregularKernel = [&](const VolIndex& vof) -> void {
+          Real velMax = 0.0;
+          for (int dir = 0; dir < SpaceDim; dir++) {
+            velMax = std::max(velMax, std::abs(velo(vof, dir)));
+          }
 
-      // If we are using MPI then ranks need to know of each other's time steps.
-      minDt = ParallelOps::min(minDt);
+          if (velMax > 0.0) {
+            minDt = std::min(dx / velMax, minDt);
+          }
+        };
+
+        // Execute the kernels.
+        BoxLoops::loop(cellBox, regularKernel);
+        BoxLoops::loop(vofit, irregularKernel);
+      }
     }
   }
 
@@ -181,13 +176,8 @@ CdrCTU::advectToFaces(EBAMRFluxData& a_facePhi, const EBAMRCellData& a_cellPhi,
     pout() << m_name + "::advectToFaces(EBAMRFluxData, EBAMRCellData, Real)" << endl;
   }
 
-  const int numberOfGhostCells = m_amr->getNumberOfGhostCells();
-
   CH_assert(a_facePhi[0]->nComp() == 1);
   CH_assert(a_cellPhi[0]->nComp() == 1);
-  CH_assert(numberOfGhostCells >= 2);
-
-  DataOps::setValue(a_facePhi, 0.0);
 
   // Ghost cells need to be interpolated. We make a copy of a_cellPhi which we use for that. This requires
   EBAMRCellData phi;
@@ -198,35 +188,57 @@ CdrCTU::advectToFaces(EBAMRFluxData& a_facePhi, const EBAMRCellData& a_cellPhi,
   m_amr->interpGhostPwl(phi, m_realm, m_phase);
 
   for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    const DisjointBoxLayout& dbl    = m_amr->getGrids(m_realm)[lvl];
-    const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
-    const ProblemDomain&     domain = m_amr->getDomains()[lvl];
-
-    for (DataIterator dit(dbl); dit.ok(); ++dit) {
-      EBFluxFAB&       facePhi = (*a_facePhi[lvl])[dit()];
-      const EBCellFAB& cellPhi = (*phi[lvl])[dit()];
-      const EBCellFAB& cellVel = (*m_cellVelocity[lvl])[dit()];
-      const EBFluxFAB& faceVel = (*m_faceVelocity[lvl])[dit()];
-
-      const Box      cellBox = dbl[dit()];
-      const EBISBox& ebisbox = ebisl[dit()];
-
-      // Limit slopes and solve Riemann problem (which yields the upwind state at the face). Note that we need one ghost cell for
-      // the slopes because in order to extrapolate to the left/right sides of a face, we need the centered slope on both
-      // sides for the upwind. So, normalSlopes is bigger than cellBox (by one). Since the limited slope is computed using the
-      // left/right slopes, we end up needing two grid cells.
-      Box grownBox = cellBox;
-      grownBox.grow(1);
-      EBCellFAB normalSlopes(ebisbox, grownBox, SpaceDim);
-      normalSlopes.setVal(0.0);
-
-      // Compute normal slopes.
-      if (m_limiter != Limiter::None) {
-        this->computeNormalSlopes(normalSlopes, cellPhi, cellBox, domain, lvl, dit());
-      }
+    this->advectToFaces(*a_facePhi[lvl], *phi[lvl], lvl, a_dt);
+  }
+}
+
+void
+CdrCTU::advectToFaces(LevelData<EBFluxFAB>&       a_facePhi,
+                      const LevelData<EBCellFAB>& a_cellPhi,
+                      const int                   a_lvl,
+                      const Real                  a_dt)
+{
+  CH_TIME("CdrCTU::advectToFaces(LD<EBFluxFAB>, LD<EBCellFAB>, int, Real)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::advectToFaces(LD<EBFluxFAB>, LD<EBCellFAB>, int, Real)" << endl;
+  }
 
-      this->upwind(facePhi, normalSlopes, cellPhi, cellVel, faceVel, domain, cellBox, lvl, dit(), a_dt);
+  const int numberOfGhostCells = m_amr->getNumberOfGhostCells();
+
+  CH_assert(a_facePhi.nComp() == 1);
+  CH_assert(a_cellPhi.nComp() == 1);
+  CH_assert(numberOfGhostCells >= 2);
+
+  DataOps::setValue(a_facePhi, 0.0);
+
+  const DisjointBoxLayout& dbl    = m_amr->getGrids(m_realm)[a_lvl];
+  const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
+  const ProblemDomain&     domain = m_amr->getDomains()[a_lvl];
+
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    EBFluxFAB&       facePhi = a_facePhi[dit()];
+    const EBCellFAB& cellPhi = a_cellPhi[dit()];
+    const EBCellFAB& cellVel = (*m_cellVelocity[a_lvl])[dit()];
+    const EBFluxFAB& faceVel = (*m_faceVelocity[a_lvl])[dit()];
+
+    const Box      cellBox = dbl[dit()];
+    const EBISBox& ebisbox = ebisl[dit()];
+
+    // Limit slopes and solve Riemann problem (which yields the upwind state at the face). Note that we need one ghost cell for
+    // the slopes because in order to extrapolate to the left/right sides of a face, we need the centered slope on both
+    // sides for the upwind. So, normalSlopes is bigger than cellBox (by one). Since the limited slope is computed using the
+    // left/right slopes, we end up needing two grid cells.
+    Box grownBox = cellBox;
+    grownBox.grow(1);
+    EBCellFAB normalSlopes(ebisbox, grownBox, SpaceDim);
+    normalSlopes.setVal(0.0);
+
+    // Compute normal slopes.
+    if (m_limiter != Limiter::None) {
+      this->computeNormalSlopes(normalSlopes, cellPhi, cellBox, domain, a_lvl, dit());
     }
+
+    this->upwind(facePhi, normalSlopes, cellPhi, cellVel, faceVel, domain, cellBox, a_lvl, dit(), a_dt);
   }
 }
 
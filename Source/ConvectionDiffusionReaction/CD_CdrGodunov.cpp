@@ -18,6 +18,7 @@
 #include <CD_CdrGodunov.H>
 #include <CD_DataOps.H>
 #include <CD_ParallelOps.H>
+#include "CD_MemoryReport.H"
 #include "CD_NamespaceHeader.H"
 
 CdrGodunov::CdrGodunov() : CdrMultigrid()
@@ -68,11 +69,11 @@ CdrGodunov::parseRuntimeOptions()
 }
 
 Real
-CdrGodunov::computeAdvectionDt()
+CdrGodunov::computeLevelAdvectionDt(const int a_lvl)
 {
-  CH_TIME("CdrGodunov::computeAdvectionDt()");
+  CH_TIME("CdrGodunov::computeLevelAdvectionDt(int)");
   if (m_verbosity > 5) {
-    pout() << m_name + "::computeAdvectionDt()" << endl;
+    pout() << m_name + "::computeLevelAdvectionDt(int)" << endl;
   }
 
   // TLDR: For advection, Bell, Collela, and Glaz says we must have dt <= dx/max(|vx|, |vy|, |vz|). See these two papers for details:
@@ -83,55 +84,50 @@ CdrGodunov::computeAdvectionDt()
   Real minDt = std::numeric_limits<Real>::max();
 
   if (m_isMobile) {
-    for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-      const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[lvl];
-      const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
-      const Real               dx    = m_amr->getDx()[lvl];
-
-      for (DataIterator dit(dbl); dit.ok(); ++dit) {
-        const Box        cellBox = dbl[dit()];
-        const EBCellFAB& velo    = (*m_cellVelocity[lvl])[dit()];
-        const EBISBox&   ebisBox = ebisl[dit()];
-
-        VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
-
-        // Regular grid data.
-        const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
-
-        // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
-        auto regularKernel = [&](const IntVect& iv) -> void {
-          Real velMax = 0.0;
-          if (ebisBox.isRegular(iv)) {
-            for (int dir = 0; dir < SpaceDim; dir++) {
-              velMax = std::max(velMax, std::abs(veloReg(iv, dir)));
-            }
-          }
+    const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[a_lvl];
+    const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
+    const Real               dx    = m_amr->getDx()[a_lvl];
 
-          if (velMax > 0.0) {
-            minDt = std::min(dx / velMax, minDt);
-          }
-        };
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const Box        cellBox = dbl[dit()];
+      const EBCellFAB& velo    = (*m_cellVelocity[a_lvl])[dit()];
+      const EBISBox&   ebisBox = ebisl[dit()];
 
-        // Same kernel, but for cut-cells.
-        auto irregularKernel = [&](const VolIndex& vof) -> void {
-          Real velMax = 0.0;
-          for (int dir = 0; dir < SpaceDim; dir++) {
-            velMax = std::max(velMax, std::abs(velo(vof, dir)));
-          }
+      VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[dit()];
 
-          if (velMax > 0.0) {
-            minDt = std::min(dx / velMax, minDt);
-          }
-        };
+      // Regular grid data.
+      const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
 
-        // Execute the kernels.
-        BoxLoops::loop(cellBox, regularKernel);
-        BoxLoops::loop(vofit, irregularKernel);
-      }
+      // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
+      auto regularKernel = [&](const IntVect& iv) -> void {
+        Real velMax = 0.0;
+        if (ebisBox.isRegular(iv)) {
+          for (int dir = 0; dir < SpaceDim; dir++) {
+            velMax = std::max(velMax, std::abs(veloReg(iv, dir)));
+          }
+        }
+
+        if (velMax > 0.0) {
+          minDt = std::min(dx / velMax, minDt);
+        }
+      };
+
+      // Same kernel, but for cut-cells.
+      auto irregularKernel = [&](const VolIndex& vof) -> void {
+        Real velMax = 0.0;
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          velMax = std::max(velMax, std::abs(velo(vof, dir)));
+        }
+
+        if (velMax > 0.0) {
+          minDt = std::min(dx / velMax, minDt);
+        }
+      };
+
+      // Execute the kernels.
+      BoxLoops::loop(cellBox, regularKernel);
+      BoxLoops::loop(vofit, irregularKernel);
     }
-
-    // If we are using MPI then ranks need to know of each other's time steps.
-    minDt = ParallelOps::min(minDt);
   }
 
   return minDt;
@@ -171,6 +167,8 @@ CdrGodunov::allocateInternals()
     pout() << m_name + "::allocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   // CdrMultigrid allocates everything except storage needed for the advection object.
   CdrMultigrid::allocateInternals();
 
@@ -220,9 +218,32 @@ CdrGodunov::advectToFaces(EBAMRFluxData& a_facePhi, const EBAMRCellData& a_cellP
   CH_assert(a_facePhi[0]->nComp() == 1);
   CH_assert(a_cellPhi[0]->nComp() == 1);
 
+  // This code extrapolates the cell-centered state to face centers on every grid level, in both space and time.
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    this->advectToFaces(*a_facePhi[lvl], *a_cellPhi[lvl], lvl, a_extrapDt);
+  }
+}
+
+void
+CdrGodunov::advectToFaces(LevelData<EBFluxFAB>&       a_facePhi,
+                          const LevelData<EBCellFAB>& a_cellPhi,
+                          const int                   a_lvl,
+                          const Real                  a_extrapDt)
+{
+  CH_TIME("CdrGodunov::advectToFaces(LD<EBFluxFAB>, LD<EBCellFAB>, int, Real)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::advectToFaces(LD<EBFluxFAB>, LD<EBCellFAB>, int, Real)" << endl;
+  }
+
+  CH_assert(a_facePhi.nComp() == 1);
+  CH_assert(a_cellPhi.nComp() == 1);
+
   // If we are extrapolating in time the source term will yield different states on the face centers. The source term is the source
   // S^k + Div(D*Grad(Phi)), which we add to the solver below. It is stored on m_scratch (which won't be used elsewhere, I think).
-  DataOps::setValue(m_scratch, 0.0);
+  // Note that m_source already has its ghost cells filled.
+  LevelData<EBCellFAB>& source = *m_scratch[a_lvl];
+
+  DataOps::setValue(source, 0.0);
 
   // Compute viscous source term for the advection.
 #if 0
@@ -235,36 +256,31 @@ CdrGodunov::advectToFaces(EBAMRFluxData& a_facePhi, const EBAMRCellData& a_cellP
 
   // If user asks for it, add the source term to the extrapolation.
   if (m_extrapolateSourceTerm && a_extrapDt > 0.0) {
-    DataOps::incr(m_scratch, m_source, 1.0);
+    DataOps::incr(source, *m_source[a_lvl], 1.0);
   }
 
-  m_amr->averageDown(m_scratch, m_realm, m_phase);
-  m_amr->interpGhost(m_scratch, m_realm, m_phase);
+  // This code extrapolates the cell-centered state to face centers, in both space and time.
+  const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[a_lvl];
 
-  // This code extrapolates the cell-centered state to face centers on every grid level, in both space and time.
-  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[lvl];
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    EBFluxFAB&       facePhi = a_facePhi[dit()];
+    const EBCellFAB& cellPhi = a_cellPhi[dit()];
+    const EBCellFAB& cellVel = (*m_cellVelocity[a_lvl])[dit()];
+    const EBFluxFAB& faceVel = (*m_faceVelocity[a_lvl])[dit()];
+    const EBCellFAB& src     = source[dit()];
+    const Real       time    = 0.0;
 
-    for (DataIterator dit(dbl); dit.ok(); ++dit) {
-      EBFluxFAB&       facePhi = (*a_facePhi[lvl])[dit()];
-      const EBCellFAB& cellPhi = (*a_cellPhi[lvl])[dit()];
-      const EBCellFAB& cellVel = (*m_cellVelocity[lvl])[dit()];
-      const EBFluxFAB& faceVel = (*m_faceVelocity[lvl])[dit()];
-      const EBCellFAB& source  = (*m_scratch[lvl])[dit()];
-      const Real       time    = 0.0;
-
-      EBAdvectPatchIntegrator& ebAdvectPatch = m_levelAdvect[lvl]->getPatchAdvect(dit());
-
-      // These are settings for EBAdvectPatchIntegrator -- it's not a very pretty design but the object has settings
-      // that permits it to run advection code (through setDoingVel(0)).
-      ebAdvectPatch.setVelocities(cellVel, faceVel);
-      ebAdvectPatch.setDoingVel(0);
-      ebAdvectPatch.setCurComp(m_comp);
-      ebAdvectPatch.setEBPhysIBC(ExtrapAdvectBCFactory());
-
-      // Extrapolate to face-centers. The face-centered states are Godunov-style extrapolated in time to a_extrapDt.
-      ebAdvectPatch.extrapolateBCG(facePhi, cellPhi, source, dit(), time, a_extrapDt);
-    }
+    EBAdvectPatchIntegrator& ebAdvectPatch = m_levelAdvect[a_lvl]->getPatchAdvect(dit());
+
+    // These are settings for EBAdvectPatchIntegrator -- it's not a very pretty design but the object has settings
+    // that permits it to run advection code (through setDoingVel(0)).
+    ebAdvectPatch.setVelocities(cellVel, faceVel);
+    ebAdvectPatch.setDoingVel(0);
+    ebAdvectPatch.setCurComp(m_comp);
+    ebAdvectPatch.setEBPhysIBC(ExtrapAdvectBCFactory());
+
+    // Extrapolate to face-centers. The face-centered states are Godunov-style extrapolated in time to a_extrapDt.
+    ebAdvectPatch.extrapolateBCG(facePhi, cellPhi, src, dit(), time, a_extrapDt);
   }
 }
 
@@ -19,6 +19,7 @@
 #include <CD_EBHelmholtzNeumannDomainBCFactory.H>
 #include <CD_EBHelmholtzDirichletDomainBCFactory.H>
 #include <CD_EBHelmholtzNeumannEBBCFactory.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 CdrMultigrid::CdrMultigrid() : CdrSolver()
@@ -54,6 +55,8 @@ CdrMultigrid::allocateInternals()
     pout() << m_name + "::allocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   CdrSolver::allocateInternals();
 }
 
@@ -260,6 +263,8 @@ CdrMultigrid::setupDiffusionSolver()
     pout() << m_name + "::setupDiffusionSolver()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Multigrid, this);
+
   // This is storage which is needed if we are doing an implicit diffusion solve. I know that not all
   // diffusion solves are implicit, but this is really the easiest way of
   if (m_isDiffusive) {
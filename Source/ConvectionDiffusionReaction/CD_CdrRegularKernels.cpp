@@ -0,0 +1,225 @@
+/* chombo-discharge
+ * Copyright © 2021 SINTEF Energy Research.
+ * Please refer to Copyright.txt and LICENSE in the chombo-discharge root directory.
+ */
+
+/*!
+  @file   CD_CdrRegularKernels.cpp
+  @brief  Implementation of CD_CdrRegularKernels.H
+  @author Robert Marskar
+*/
+
+// Std includes
+#include <utility>
+
+// Our includes
+#include <CD_CdrRegularKernels.H>
+#include <CD_Decorations.H>
+#include <CD_NamespaceHeader.H>
+
+namespace CdrRegularKernels {
+
+  /*!
+    @brief Helper class for indexing into the raw data of a BaseFab<Real>
+    @details The offset is computed once per row (i.e., per j/k), and the innermost loop then runs over contiguous memory. 
+  */
+  template <typename T>
+  class RawFab
+  {
+  public:
+    /*!
+      @brief Constructor. Sets up strides and base pointer.
+      @param[in] a_fab  Data holder
+      @param[in] a_comp Component
+    */
+    RawFab(T& a_fab, const int a_comp)
+    {
+      const Box& box = a_fab.box();
+
+      m_data = a_fab.dataPtr(a_comp);
+
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        m_lo[dir] = box.smallEnd(dir);
+      }
+
+      m_stride[0] = 1;
+      for (int dir = 1; dir < SpaceDim; dir++) {
+        m_stride[dir] = m_stride[dir - 1] * box.size(dir - 1);
+      }
+    }
+
+    /*!
+      @brief Get pointer to the row starting at iv
+      @param[in] a_iv Grid index
+    */
+    inline decltype(std::declval<T&>().dataPtr(0))
+    row(const IntVect& a_iv) const
+    {
+      long offset = 0;
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        offset += (a_iv[dir] - m_lo[dir]) * m_stride[dir];
+      }
+
+      return m_data + offset;
+    }
+
+    /*!
+      @brief Get stride along a coordinate direction
+      @param[in] a_dir Coordinate direction
+    */
+    inline long
+    stride(const int a_dir) const
+    {
+      return m_stride[a_dir];
+    }
+
+  protected:
+    /*!
+      @brief Pointer to data for the component
+    */
+    decltype(std::declval<T&>().dataPtr(0)) m_data;
+
+    /*!
+      @brief Lower corner of the data holder box
+    */
+    int m_lo[SpaceDim];
+
+    /*!
+      @brief Strides along each coordinate direction
+    */
+    long m_stride[SpaceDim];
+  };
+
+  /*!
+    @brief Run a row-kernel over each row (i.e., fixed j/k) in a box.
+    @param[in] a_box    Computation box
+    @param[in] a_kernel Kernel, called with the starting IntVect of each row and the row length
+  */
+  template <typename Functor>
+  ALWAYS_INLINE void
+  rowLoop(const Box& a_box, Functor&& a_kernel)
+  {
+    const int* lo = a_box.loVect();
+    const int* hi = a_box.hiVect();
+
+    const int rowLength = hi[0] - lo[0] + 1;
+
+#if CH_SPACEDIM == 3
+    for (int k = lo[2]; k <= hi[2]; k++) {
+#endif
+      for (int j = lo[1]; j <= hi[1]; j++) {
+        a_kernel(IntVect(D_DECL(lo[0], j, k)), rowLength);
+      }
+#if CH_SPACEDIM == 3
+    }
+#endif
+  }
+} // namespace CdrRegularKernels
+
+void
+CdrRegularKernels::advectiveFlux(BaseFab<Real>&       a_flux,
+                                 const BaseFab<Real>& a_phi,
+                                 const BaseFab<Real>& a_vel,
+                                 const Box&           a_faceBox,
+                                 const int            a_comp)
+{
+  CH_assert(a_flux.box().contains(a_faceBox));
+  CH_assert(a_phi.box().contains(a_faceBox));
+  CH_assert(a_vel.box().contains(a_faceBox));
+
+  const RawFab<BaseFab<Real>>       flux(a_flux, a_comp);
+  const RawFab<const BaseFab<Real>> phi(a_phi, a_comp);
+  const RawFab<const BaseFab<Real>> vel(a_vel, a_comp);
+
+  auto kernel = [&](const IntVect& iv, const int n) -> void {
+    Real* __restrict__ F       = flux.row(iv);
+    const Real* __restrict__ P = phi.row(iv);
+    const Real* __restrict__ V = vel.row(iv);
+
+    CD_PRAGMA_SIMD
+    for (int i = 0; i < n; i++) {
+      F[i] = P[i] * V[i];
+    }
+  };
+
+  rowLoop(a_faceBox, kernel);
+}
+
+void
+CdrRegularKernels::diffusiveFlux(BaseFab<Real>&       a_flux,
+                                 const BaseFab<Real>& a_phi,
+                                 const BaseFab<Real>& a_dco,
+                                 const Box&           a_faceBox,
+                                 const int            a_dir,
+                                 const Real           a_inverseDx,
+                                 const int            a_comp)
+{
+  CH_assert(a_flux.box().contains(a_faceBox));
+  CH_assert(a_dco.box().contains(a_faceBox));
+
+  const RawFab<BaseFab<Real>>       flux(a_flux, a_comp);
+  const RawFab<const BaseFab<Real>> phi(a_phi, a_comp);
+  const RawFab<const BaseFab<Real>> dco(a_dco, a_comp);
+
+  // The kernel is called for a face-centered box so the cell on the high side is at iv and the cell on the low side
+  // is at iv - BASISV(dir). In memory, that cell is one stride away.
+  const long lowOffset = phi.stride(a_dir);
+
+  auto kernel = [&](const IntVect& iv, const int n) -> void {
+    Real* __restrict__ F         = flux.row(iv);
+    const Real* __restrict__ D   = dco.row(iv);
+    const Real* __restrict__ PHi = phi.row(iv);
+    const Real* __restrict__ PLo = PHi - lowOffset;
+
+    CD_PRAGMA_SIMD
+    for (int i = 0; i < n; i++) {
+      F[i] = a_inverseDx * D[i] * (PHi[i] - PLo[i]);
+    }
+  };
+
+  rowLoop(a_faceBox, kernel);
+}
+
+void
+CdrRegularKernels::conservativeDivergence(BaseFab<Real>&             a_divF,
+                                          const BaseFab<Real>* const a_fluxes[SpaceDim],
+                                          const Box&                 a_cellBox,
+                                          const Real                 a_inverseDx,
+                                          const int                  a_comp)
+{
+  CH_assert(a_divF.box().contains(a_cellBox));
+
+  const RawFab<BaseFab<Real>> divF(a_divF, a_comp);
+
+  // Pointers to the face data in each direction. The flux on the high face of a cell is one stride away from the flux on the
+  // low face.
+  const RawFab<const BaseFab<Real>> fluxX(*a_fluxes[0], a_comp);
+  const RawFab<const BaseFab<Real>> fluxY(*a_fluxes[1], a_comp);
+#if CH_SPACEDIM == 3
+  const RawFab<const BaseFab<Real>> fluxZ(*a_fluxes[2], a_comp);
+#endif
+
+  const long strideX = fluxX.stride(0);
+  const long strideY = fluxY.stride(1);
+#if CH_SPACEDIM == 3
+  const long strideZ = fluxZ.stride(2);
+#endif
+
+  auto kernel = [&](const IntVect& iv, const int n) -> void {
+    Real* __restrict__ div      = divF.row(iv);
+    const Real* __restrict__ FX = fluxX.row(iv);
+    const Real* __restrict__ FY = fluxY.row(iv);
+#if CH_SPACEDIM == 3
+    const Real* __restrict__ FZ = fluxZ.row(iv);
+#endif
+
+    CD_PRAGMA_SIMD
+    for (int i = 0; i < n; i++) {
+      div[i] = a_inverseDx * (D_TERM(FX[i + strideX] - FX[i], +FY[i + strideY] - FY[i], +FZ[i + strideZ] - FZ[i]));
+    }
+  };
+
+  rowLoop(a_cellBox, kernel);
+}
+
+#include <CD_NamespaceFooter.H>
@@ -18,11 +18,13 @@
 
 // Our includes
 #include <CD_CdrSolver.H>
+#include <CD_CdrRegularKernels.H>
 #include <CD_DataOps.H>
 #include <CD_BoxLoops.H>
 #include <CD_ParallelOps.H>
 #include <CD_DischargeIO.H>
 #include <CD_Random.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr int CdrSolver::m_comp;
@@ -41,7 +43,7 @@ CdrSolver::CdrSolver()
   this->setDefaultDomainBC(); // Set default domain BCs (wall)
 }
 
-CdrSolver::~CdrSolver() {}
+CdrSolver::~CdrSolver() { MemoryReport::releaseMemory(this); }
 
 void
 CdrSolver::setDefaultDomainBC()
@@ -195,7 +197,7 @@ CdrSolver::advanceEuler(EBAMRCellData& a_newPhi, const EBAMRCellData& a_oldPhi,
   //       version.
   if (m_isDiffusive) {
     EBAMRCellData src;
-    m_amr->allocate(src, m_realm, m_phase, m_nComp);
+    m_amr->allocateScratch(src, m_realm, m_phase, m_nComp);
     DataOps::setValue(src, 0.0);
 
     this->advanceEuler(a_newPhi, a_oldPhi, src, a_dt);
@@ -220,7 +222,7 @@ CdrSolver::advanceCrankNicholson(EBAMRCellData& a_newPhi, const EBAMRCellData& a
   //       version.
   if (m_isDiffusive) {
     EBAMRCellData src;
-    m_amr->allocate(src, m_realm, m_phase, m_nComp);
+    m_amr->allocateScratch(src, m_realm, m_phase, m_nComp);
     DataOps::setValue(src, 0.0);
 
     this->advanceCrankNicholson(a_newPhi, a_oldPhi, src, a_dt);
@@ -238,6 +240,8 @@ CdrSolver::allocateInternals()
     pout() << m_name + "::allocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   // TLDR: This allocates a number of fields for this solver. We wish to trim memory if we can, so we don't allocate
   //       storage for velocities/diffusion coefficients if those fields are not going to be used. Somewhat confusingly,
   //       we allocate pointers for these fields but no memory blocks (for interface reasons).
@@ -315,6 +319,8 @@ CdrSolver::deallocateInternals()
   }
 
   // TLDR: This deallocates a bunch of storage. This can be used during regrids to trim memory (because the Berger-Rigoutsous algorithm eats memory).
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   m_amr->deallocate(m_phi);
   m_amr->deallocate(m_source);
   m_amr->deallocate(m_faceVelocity);
@@ -564,26 +570,39 @@ CdrSolver::computeAdvectionFlux(LevelData<EBFluxFAB>&       a_flux,
   const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
   const ProblemDomain&     domain = m_amr->getDomains()[a_lvl];
 
+  // The face states and velocities are only defined in the ghost cells that they were allocated with, so the cut-cell fluxes
+  // can't be computed beyond that.
+  IntVect numGhost = a_flux.ghostVect();
+  numGhost.min(a_facePhi.ghostVect());
+  numGhost.min(a_faceVelocity.ghostVect());
+
   for (DataIterator dit(dbl); dit.ok(); ++dit) {
-    const Box      cellBox = dbl[dit()];
     const EBISBox& ebisbox = ebisl[dit()];
     const EBGraph& ebgraph = ebisbox.getEBGraph();
 
+    // The stencil we use will interpolate to the face centroids, so we need to correct the fluxes on cell centers, but
+    // including tangential ghost faces around the grid patch.
+    const Box irregCellBox = grow(dbl[dit()], numGhost) & domain;
+
     for (int dir = 0; dir < SpaceDim; dir++) {
       EBFaceFAB&       flux = a_flux[dit()][dir];
       const EBFaceFAB& phi  = a_facePhi[dit()][dir];
       const EBFaceFAB& vel  = a_faceVelocity[dit()][dir];
 
-      flux.setVal(0.0, m_comp);
-      flux += phi;
-      flux *= vel;
+      // Regular faces are done with a vectorized kernel on the single-valued data. This writes to the cut-cell faces
+      // as well, but those are fixed up below.
+      Box faceBox = flux.getRegion();
+      faceBox &= phi.getRegion();
+      faceBox &= vel.getRegion();
 
-      // The stencil we use will interpolate to the face centroids, so we need to correct the fluxes on cell centers, but including tangential ghost faces
-      // around the grid patch.
-      Box grownCellBox = grow(cellBox, 1) & domain;
+      CdrRegularKernels::advectiveFlux(flux.getSingleValuedFAB(),
+                                       phi.getSingleValuedFAB(),
+                                       vel.getSingleValuedFAB(),
+                                       faceBox,
+                                       m_comp);
 
       // Irregular faces
-      FaceIterator faceit(ebisbox.getIrregIVS(grownCellBox), ebgraph, dir, FaceStop::SurroundingWithBoundary);
+      FaceIterator faceit(ebisbox.getIrregIVS(irregCellBox), ebgraph, dir, FaceStop::SurroundingWithBoundary);
       auto kernel = [&](const FaceIndex& face) -> void { flux(face, m_comp) = vel(face, m_comp) * phi(face, m_comp); };
 
       BoxLoops::loop(faceit, kernel);
@@ -669,12 +688,6 @@ CdrSolver::computeDiffusionFlux(LevelData<EBFluxFAB>& a_flux, const LevelData<EB
       const Box    grownFaceBox = surroundingNodes(grownCellBox, dir);
       FaceIterator faceit(ebisbox.getIrregIVS(grownCellBox), ebgraph, dir, FaceStop::SurroundingWithBoundary);
 
-      // Regular kernel. Note that we call the kernel on a face-centered box, so the cell on the high side is located at
-      // iv, and the cell at the low side is at iv - BASISV(dir).
-      auto regularKernel = [&](const IntVect& iv) -> void {
-        regFlux(iv, m_comp) = inverseDx * regDco(iv, m_comp) * (regPhi(iv, m_comp) - regPhi(iv - BASISV(dir), m_comp));
-      };
-
       // Cut-cell kernel. Basically the same as the above but we need to explicity get vofs on the low/high side (because
       // we may have multi-cells but the above kernel only does single-valued cells).
       auto irregularKernel = [&](const FaceIndex& face) -> void {
@@ -686,8 +699,9 @@ CdrSolver::computeDiffusionFlux(LevelData<EBFluxFAB>& a_flux, const LevelData<EB
         }
       };
 
-      // Execute kernels.
-      BoxLoops::loop(grownFaceBox, regularKernel);
+      // Execute kernels. The regular kernel is called on a face-centered box, so the cell on the high side is located
+      // at iv, and the cell at the low side is at iv - BASISV(dir).
+      CdrRegularKernels::diffusiveFlux(regFlux, regPhi, regDco, grownFaceBox, dir, inverseDx, m_comp);
       BoxLoops::loop(faceit, irregularKernel);
     }
   }
@@ -790,45 +804,58 @@ CdrSolver::resetDomainFlux(EBAMRFluxData& a_flux)
 
   CH_assert(a_flux[0]->nComp() == 1);
 
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    this->resetDomainFlux(*a_flux[lvl], lvl);
+  }
+}
+
+void
+CdrSolver::resetDomainFlux(LevelData<EBFluxFAB>& a_flux, const int a_lvl)
+{
+  CH_TIME("CdrSolver::resetDomainFlux(LD<EBFluxFAB>, int)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::resetDomainFlux(LD<EBFluxFAB>, int)" << endl;
+  }
+
+  CH_assert(a_flux.nComp() == 1);
+
   // TLDR: This routine iterates through all faces in a_flux which are boundary faces and sets the flux there to zero.
 
   constexpr Real zero = 0.0;
 
-  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    const DisjointBoxLayout& dbl    = m_amr->getGrids(m_realm)[lvl];
-    const ProblemDomain&     domain = m_amr->getDomains()[lvl];
-    const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
+  const DisjointBoxLayout& dbl    = m_amr->getGrids(m_realm)[a_lvl];
+  const ProblemDomain&     domain = m_amr->getDomains()[a_lvl];
+  const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
 
-    for (DataIterator dit(dbl); dit.ok(); ++dit) {
-      const Box      cellBox = dbl[dit()];
-      const EBISBox& ebisbox = ebisl[dit()];
-      const EBGraph& ebgraph = ebisbox.getEBGraph();
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    const Box      cellBox = dbl[dit()];
+    const EBISBox& ebisbox = ebisl[dit()];
+    const EBGraph& ebgraph = ebisbox.getEBGraph();
 
-      for (int dir = 0; dir < SpaceDim; dir++) {
-        EBFaceFAB&     flux    = (*a_flux[lvl])[dit()][dir];
-        BaseFab<Real>& regFlux = flux.getSingleValuedFAB();
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      EBFaceFAB&     flux    = a_flux[dit()][dir];
+      BaseFab<Real>& regFlux = flux.getSingleValuedFAB();
 
-        for (SideIterator sit; sit.ok(); ++sit) {
-          const Side::LoHiSide side = sit();
+      for (SideIterator sit; sit.ok(); ++sit) {
+        const Side::LoHiSide side = sit();
 
-          // Create a cell box which lies next to the domain. Also make an iterator over the cut-cell faces.
-          const Box    boundaryCellBox = adjCellBox(domain.domainBox(), dir, side, -1) & cellBox;
-          FaceIterator faceit(ebisbox.getIrregIVS(boundaryCellBox), ebgraph, dir, FaceStop::AllBoundaryOnly);
+        // Create a cell box which lies next to the domain. Also make an iterator over the cut-cell faces.
+        const Box    boundaryCellBox = adjCellBox(domain.domainBox(), dir, side, -1) & cellBox;
+        FaceIterator faceit(ebisbox.getIrregIVS(boundaryCellBox), ebgraph, dir, FaceStop::AllBoundaryOnly);
 
-          const int     sign  = (side == Side::Lo) ? 0 : 1;
-          const IntVect shift = sign * BASISV(dir);
+        const int     sign  = (side == Side::Lo) ? 0 : 1;
+        const IntVect shift = sign * BASISV(dir);
 
-          // Regular kernel -- note the shift to make sure that cell indices map to face indices. I am doing this because
-          // if we were to convert the box to a face-centered box we would do another layer of faces. So shift directly.
-          auto regularKernel = [&](const IntVect& iv) -> void { regFlux(iv + shift, m_comp) = zero; };
+        // Regular kernel -- note the shift to make sure that cell indices map to face indices. I am doing this because
+        // if we were to convert the box to a face-centered box we would do another layer of faces. So shift directly.
+        auto regularKernel = [&](const IntVect& iv) -> void { regFlux(iv + shift, m_comp) = zero; };
 
-          // Irregular kernel. Same as the above really.
-          auto irregularKernel = [&](const FaceIndex& face) -> void { flux(face, m_comp) = 0.0; };
+        // Irregular kernel. Same as the above really.
+        auto irregularKernel = [&](const FaceIndex& face) -> void { flux(face, m_comp) = 0.0; };
 
-          // Execute kernels
-          BoxLoops::loop(boundaryCellBox, regularKernel);
-          BoxLoops::loop(faceit, irregularKernel);
-        }
+        // Execute kernels
+        BoxLoops::loop(boundaryCellBox, regularKernel);
+        BoxLoops::loop(faceit, irregularKernel);
       }
     }
   }
@@ -978,17 +1005,22 @@ CdrSolver::conservativeDivergenceNoKappaDivision(EBAMRCellData&     a_conservati
   //
   // This routine computes just that: a_conservativeDivergence = kappa*div(F) = Sum(fluxes).
   //
+  // The divergence only uses the faces of each grid box, so the flux ghost faces are exchanged while we compute it.
   for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    a_flux[lvl]->exchange();
+    LevelData<EBFluxFAB>& flux = *a_flux[lvl];
+
+    flux.exchangeBegin(m_amr->getExchangeCopier(m_realm, lvl, flux.ghostVect()));
 
     this->conservativeDivergenceRegular(*a_conservativeDivergence[lvl],
-                                        *a_flux[lvl],
+                                        flux,
                                         lvl); // Compute kappa*div(F) in regular cells
     this->computeDivergenceIrregular(*a_conservativeDivergence[lvl],
-                                     *a_flux[lvl],
+                                     flux,
                                      *a_ebFlux[lvl],
                                      lvl); // Recompute divergence on irregular cells
 
+    flux.exchangeEnd();
+
     a_conservativeDivergence[lvl]->exchange();
   }
 
@@ -1087,20 +1119,15 @@ CdrSolver::conservativeDivergenceRegular(LevelData<EBCellFAB>&       a_divJ,
 
     divJ.setVal(0.0);
 
+    // Regular kernel. This is called for a cell-centered box so the high flux is on iv + BASISV(dir) and the low flux
+    // on iv. All directions are done in the same pass.
+    const BaseFab<Real>* fluxReg[SpaceDim];
     for (int dir = 0; dir < SpaceDim; dir++) {
-      const EBFaceFAB&     flux    = a_flux[dit()][dir];
-      const BaseFab<Real>& fluxReg = flux.getSingleValuedFAB();
-
-      // Regular kernel. We call this for a cell-centered box so the high flux is on iv + BASISV(dir) and the low flux
-      // on iv + BASISV(dir);
-      auto regularKernel = [&](const IntVect& iv) -> void {
-        divJReg(iv, m_comp) += inverseDx * (fluxReg(iv + BASISV(dir), m_comp) - fluxReg(iv, m_comp));
-      };
-
-      // Execute the kernel.
-      BoxLoops::loop(cellBox, regularKernel);
+      fluxReg[dir] = &(a_flux[dit()][dir].getSingleValuedFAB());
     }
 
+    CdrRegularKernels::conservativeDivergence(divJReg, fluxReg, cellBox, inverseDx, m_comp);
+
     // Reset irregular grid cells. These will be computed in a different way.
     VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[dit()];
 
@@ -1108,8 +1135,6 @@ CdrSolver::conservativeDivergenceRegular(LevelData<EBCellFAB>&       a_divJ,
 
     BoxLoops::loop(vofit, irregularKernel);
   }
-
-  a_divJ.exchange();
 }
 
 void
@@ -1683,6 +1708,238 @@ CdrSolver::reflux(EBAMRCellData& a_phi)
   }
 }
 
+void
+CdrSolver::advectSubcycled(EBAMRCellData& a_phi,
+                           const Real     a_dt,
+                           const bool     a_extrapolate,
+                           const bool     a_ebFlux,
+                           const bool     a_domainFlux)
+{
+  CH_TIME("CdrSolver::advectSubcycled(EBAMRCellData, Real, bool, bool, bool)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::advectSubcycled(EBAMRCellData, Real, bool, bool, bool)" << endl;
+  }
+
+  CH_assert(a_phi[0]->nComp() == 1);
+
+  // TLDR: This is a Berger-Oliger type of advance where each level is advanced with its own time step. Level l is advanced once
+  //       and then level l+1 is advanced r_l times with dt/r_l, after which the levels are synchronized: The flux registers correct
+  //       the coarse-level solution along the refinement boundary so that the coarse flux matches the time-integrated fine-level fluxes,
+  //       and the mass from the hybrid divergence that was redistributed across the refinement boundary is put back in. The velocities
+  //       and EB fluxes are held fixed over the coarse step.
+
+  if (m_isMobile) {
+    m_amr->averageDown(a_phi, m_realm, m_phase);
+    m_amr->interpGhostPwl(a_phi, m_realm, m_phase);
+    m_amr->interpGhostPwl(m_cellVelocity, m_realm, m_phase);
+
+    if (m_whichRedistribution == Redistribution::MassWeighted) {
+      this->setRedistWeights(a_phi);
+    }
+
+    this->averageVelocityToFaces();
+
+    // Storage for the old solution (used for time-interpolating ghost cells on the finer levels) and the divergence.
+    EBAMRCellData phiOld;
+    EBAMRCellData divF;
+
+    m_amr->allocateScratch(phiOld, m_realm, m_phase, m_nComp);
+    m_amr->allocateScratch(divF, m_realm, m_phase, m_nComp);
+
+    DataOps::setValue(divF, 0.0);
+
+    // Recursively advance the levels.
+    this->advectLevel(a_phi, phiOld, divF, 0, a_dt, 0.0, a_extrapolate, a_ebFlux, a_domainFlux);
+
+    m_amr->interpGhost(a_phi, m_realm, m_phase);
+  }
+}
+
+void
+CdrSolver::advectLevel(EBAMRCellData& a_phi,
+                       EBAMRCellData& a_phiOld,
+                       EBAMRCellData& a_divF,
+                       const int      a_lvl,
+                       const Real     a_dt,
+                       const Real     a_theta,
+                       const bool     a_extrapolate,
+                       const bool     a_ebFlux,
+                       const bool     a_domainFlux)
+{
+  CH_TIME("CdrSolver::advectLevel(EBAMRCellData, EBAMRCellData, EBAMRCellData, int, Real, Real, bool, bool, bool)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::advectLevel(EBAMRCellData, EBAMRCellData, EBAMRCellData, int, Real, Real, bool, bool, bool)"
+           << endl;
+  }
+
+  const Interval interv(m_comp, m_comp);
+
+  const int  finestLevel = m_amr->getFinestLevel();
+  const bool hasCoar     = a_lvl > 0;
+  const bool hasFine     = a_lvl < finestLevel;
+  const bool redist      = m_whichRedistribution != Redistribution::None;
+
+  const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[a_lvl];
+  const Real               dx  = m_amr->getDx()[a_lvl];
+
+  Vector<RefCountedPtr<EBFluxRegister>>& fluxReg = m_amr->getFluxRegister(m_realm, m_phase);
+
+  EBLevelRedist& levelRedist = *m_amr->getLevelRedist(m_realm, m_phase)[a_lvl];
+
+  // Registers between this level and the finer level are filled during this step and the fine-level substeps. The register
+  // between this level and the coarser level is reset by the coarser level, since it accumulates over all our substeps.
+  if (hasFine) {
+    fluxReg[a_lvl]->setToZero();
+
+    if (redist) {
+      m_amr->getCoarToFineRedist(m_realm, m_phase)[a_lvl]->setToZero();
+      m_amr->getCoarToCoarRedist(m_realm, m_phase)[a_lvl]->setToZero();
+      m_amr->getFineToCoarRedist(m_realm, m_phase)[a_lvl + 1]->setToZero();
+    }
+  }
+
+  // Store the old solution and fill ghost cells. On the finer levels the coarse data is interpolated in time between the beginning
+  // and the end of the coarse-level step.
+  LevelData<EBCellFAB>& phi    = *a_phi[a_lvl];
+  LevelData<EBCellFAB>& divF   = *a_divF[a_lvl];
+  LevelData<EBCellFAB>& phiOld = *a_phiOld[a_lvl];
+
+  phi.localCopyTo(phiOld);
+
+  if (hasCoar) {
+    m_amr->interpGhost(phi, *a_phiOld[a_lvl - 1], *a_phi[a_lvl - 1], a_theta, a_lvl, m_realm, m_phase);
+  }
+  phi.exchange();
+
+  // Compute face-centered fluxes on this level.
+  LevelData<EBFluxFAB>& facePhi = *m_faceStates[a_lvl];
+  LevelData<EBFluxFAB>& flux    = *m_scratchFluxOne[a_lvl];
+
+  this->advectToFaces(facePhi, phi, a_lvl, a_extrapolate ? a_dt : 0.0);
+  this->computeAdvectionFlux(flux, facePhi, *m_faceVelocity[a_lvl], a_lvl);
+
+  if (a_domainFlux) {
+    this->fillDomainFlux(flux, a_lvl);
+  }
+  else {
+    this->resetDomainFlux(flux, a_lvl);
+  }
+
+  flux.exchange();
+  this->interpolateFluxToFaceCentroids(flux, a_lvl);
+
+  // Compute kappa*div(F) and the hybrid divergence. The non-conservative divergence needs ghost cells, which we get from the
+  // divergence that was computed on the coarser level. Note that the coarse divergence is the one from the coarse-level step,
+  // i.e. it is centered at a different time than ours and it is not interpolated in time. This is a first-order approximation,
+  // but it only enters in the cut-cells next to the refinement boundary, through the non-conservative divergence. The mass
+  // that is missed because of this is redistributed, so it does not affect conservation.
+  const LevelData<BaseIVFAB<Real>>& ebFlux = a_ebFlux ? *m_ebFlux[a_lvl] : *m_ebZero[a_lvl];
+
+  this->conservativeDivergenceRegular(divF, flux, a_lvl);
+  this->computeDivergenceIrregular(divF, flux, ebFlux, a_lvl);
+
+  if (hasCoar) {
+    m_amr->interpGhost(divF, *a_divF[a_lvl - 1], a_lvl, m_realm, m_phase);
+  }
+  divF.exchange();
+
+  if (m_blendConservation) {
+    m_amr->getNonConservativeDivergenceStencils(m_realm, m_phase).apply(*m_nonConservativeDivG[a_lvl], divF, a_lvl);
+  }
+  else {
+    DataOps::setValue(*m_nonConservativeDivG[a_lvl], 0.0);
+  }
+
+  this->hybridDivergence(divF, *m_massDifference[a_lvl], *m_nonConservativeDivG[a_lvl], a_lvl);
+
+  // Update the solution.
+  DataOps::incr(phi, divF, -a_dt);
+
+  // Redistribute the mass that was missed by the hybrid divergence. The level redistribution goes in right away while the redistribution
+  // across the refinement boundaries goes in when the levels are synchronized.
+  if (redist) {
+    LevelData<BaseIVFAB<Real>>& massDiff = *m_massDifference[a_lvl];
+
+    DataOps::scale(massDiff, -a_dt);
+
+    levelRedist.setToZero();
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      levelRedist.increment(massDiff[dit()], dit(), interv);
+
+      if (hasCoar) {
+        m_amr->getFineToCoarRedist(m_realm, m_phase)[a_lvl]->increment(massDiff[dit()], dit(), interv);
+      }
+      if (hasFine) {
+        m_amr->getCoarToFineRedist(m_realm, m_phase)[a_lvl]->increment(massDiff[dit()], dit(), interv);
+        m_amr->getCoarToCoarRedist(m_realm, m_phase)[a_lvl]->increment(massDiff[dit()], dit(), interv);
+      }
+    }
+
+    levelRedist.redistribute(phi, interv);
+    levelRedist.setToZero();
+  }
+
+  // Increment the flux registers with the time-integrated fluxes.
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      const EBFaceFAB& faceFlux = flux[dit()][dir];
+
+      for (SideIterator sit; sit.ok(); ++sit) {
+        if (hasFine) {
+          fluxReg[a_lvl]->incrementCoarseBoth(faceFlux, a_dt, dit(), interv, dir, sit());
+        }
+        if (hasCoar) {
+          fluxReg[a_lvl - 1]->incrementFineBoth(faceFlux, a_dt, dit(), interv, dir, sit());
+        }
+      }
+    }
+  }
+
+  // Advance the finer level and synchronize.
+  if (hasFine) {
+    const int  nref   = m_amr->getRefinementRatios()[a_lvl];
+    const Real fineDt = a_dt / nref;
+
+    for (int isub = 0; isub < nref; isub++) {
+
+      // Time (as a fraction of our time step) where the fine level reads its ghost cells. When the face states are extrapolated
+      // in time, the ghost cells are predicted forward together with the valid cells, so they must be at the start of the substep.
+      // Otherwise the ghost cells are used directly for the inflow fluxes across the refinement boundary, and we use the coarse
+      // data at the middle of the substep. This gives the midpoint rule for the time-integrated fine-level fluxes.
+      const Real theta = a_extrapolate ? (1.0 * isub) / nref : (isub + 0.5) / nref;
+
+      this->advectLevel(a_phi, a_phiOld, a_divF, a_lvl + 1, fineDt, theta, a_extrapolate, a_ebFlux, a_domainFlux);
+    }
+
+    // Reflux. Note the sign -- we have phi^(k+1) = phi^k - dt*div(F) so the flux mismatch enters with a negative sign.
+    const Real scale = -1.0 / dx;
+
+    fluxReg[a_lvl]->reflux(phi, interv, scale);
+
+    if (redist) {
+      RefCountedPtr<EBCoarToFineRedist>& coar2fineRedist = m_amr->getCoarToFineRedist(m_realm, m_phase)[a_lvl];
+      RefCountedPtr<EBCoarToCoarRedist>& coar2coarRedist = m_amr->getCoarToCoarRedist(m_realm, m_phase)[a_lvl];
+      RefCountedPtr<EBFineToCoarRedist>& fine2coarRedist = m_amr->getFineToCoarRedist(m_realm, m_phase)[a_lvl + 1];
+
+      // Refluxing changes the mass in coarse cut-cells next to the refinement boundary; that mass must be re-redistributed.
+      fluxReg[a_lvl]->incrementRedistRegister(*coar2coarRedist, interv, scale);
+
+      coar2fineRedist->redistribute(*a_phi[a_lvl + 1], interv);
+      coar2coarRedist->redistribute(phi, interv);
+      fine2coarRedist->redistribute(phi, interv);
+
+      coar2fineRedist->setToZero();
+      coar2coarRedist->setToZero();
+      fine2coarRedist->setToZero();
+    }
+
+    fluxReg[a_lvl]->setToZero();
+
+    m_amr->averageDown(a_phi, m_realm, m_phase, a_lvl);
+  }
+}
+
 void
 CdrSolver::setAmr(const RefCountedPtr<AmrMesh>& a_amr)
 {
@@ -2135,57 +2392,104 @@ CdrSolver::computeAdvectionDt()
     pout() << m_name + "::computeAdvectionDt()" << endl;
   }
 
-  // TLDR: For advection we must have dt <= dx/(|vx|+|vy|+|vz|). E.g., with first order upwind phi^(k+1)_i = phi^k_i - (v*dt) * (phi^k_i - phi^k_(i-1))/dx so
-  //       if phi^k_(i-1) == 0 then (1 - v*dt/dx) > 0.0 yields a positive definite solution (more general analysis when we have limiters is probably possible...)
+  Real minDt = std::numeric_limits<Real>::max();
+
+  if (m_isMobile) {
+    for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+      minDt = std::min(minDt, this->computeLevelAdvectionDt(lvl));
+    }
+
+    // If we are using MPI then ranks need to know of each other's time steps.
+    minDt = ParallelOps::min(minDt);
+  }
+
+  return minDt;
+}
+
+Real
+CdrSolver::computeSubcycledAdvectionDt()
+{
+  CH_TIME("CdrSolver::computeSubcycledAdvectionDt()");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeSubcycledAdvectionDt()" << endl;
+  }
+
+  // TLDR: With subcycling, level l advances with dt/(r_0*r_1*...*r_(l-1)) so the level time step is scaled up by the
+  //       product of the refinement ratios when we compute the time step on the coarsest level.
+
+  const Vector<int>& refRat = m_amr->getRefinementRatios();
 
   Real minDt = std::numeric_limits<Real>::max();
 
   if (m_isMobile) {
+    Real factor = 1.0;
+
     for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-      const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[lvl];
-      const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
-      const Real               dx    = m_amr->getDx()[lvl];
+      minDt = std::min(minDt, factor * this->computeLevelAdvectionDt(lvl));
 
-      for (DataIterator dit(dbl); dit.ok(); ++dit) {
-        const Box        cellBox = dbl[dit()];
-        const EBCellFAB& velo    = (*m_cellVelocity[lvl])[dit()];
-        const EBISBox&   ebisBox = ebisl[dit()];
+      factor *= refRat[lvl];
+    }
 
-        VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
+    minDt = ParallelOps::min(minDt);
+  }
 
-        // Regular grid data.
-        const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
+  return minDt;
+}
 
-        // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
-        auto regularKernel = [&](const IntVect& iv) -> void {
-          if (!ebisBox.isCovered(iv)) {
-            Real vel = 0.0;
-            for (int dir = 0; dir < SpaceDim; dir++) {
-              vel += std::abs(veloReg(iv, dir));
-            }
+Real
+CdrSolver::computeLevelAdvectionDt(const int a_lvl)
+{
+  CH_TIME("CdrSolver::computeLevelAdvectionDt(int)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeLevelAdvectionDt(int)" << endl;
+  }
 
-            minDt = std::min(dx / vel, minDt);
-          }
-        };
+  // TLDR: For advection we must have dt <= dx/(|vx|+|vy|+|vz|). E.g., with first order upwind phi^(k+1)_i = phi^k_i - (v*dt) * (phi^k_i - phi^k_(i-1))/dx so
+  //       if phi^k_(i-1) == 0 then (1 - v*dt/dx) > 0.0 yields a positive definite solution (more general analysis when we have limiters is probably possible...)
 
-        // Same kernel, but for cut-cells.
-        auto irregularKernel = [&](const VolIndex& vof) -> void {
+  Real minDt = std::numeric_limits<Real>::max();
+
+  if (m_isMobile) {
+    const DisjointBoxLayout& dbl   = m_amr->getGrids(m_realm)[a_lvl];
+    const EBISLayout&        ebisl = m_amr->getEBISLayout(m_realm, m_phase)[a_lvl];
+    const Real               dx    = m_amr->getDx()[a_lvl];
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const Box        cellBox = dbl[dit()];
+      const EBCellFAB& velo    = (*m_cellVelocity[a_lvl])[dit()];
+      const EBISBox&   ebisBox = ebisl[dit()];
+
+      VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[a_lvl])[dit()];
+
+      // Regular grid data.
+      const BaseFab<Real>& veloReg = velo.getSingleValuedFAB();
+
+      // Compute dt = dx/(|vx|+|vy|+|vz|) and check if it's smaller than the smallest so far.
+      auto regularKernel = [&](const IntVect& iv) -> void {
+        if (!ebisBox.isCovered(iv)) {
           Real vel = 0.0;
           for (int dir = 0; dir < SpaceDim; dir++) {
-            vel += std::abs(velo(vof, dir));
+            vel += std::abs(veloReg(iv, dir));
           }
 
           minDt = std::min(dx / vel, minDt);
-        };
+        }
+      };
 
-        // Execute the kernels.
-        BoxLoops::loop(cellBox, regularKernel);
-        BoxLoops::loop(vofit, irregularKernel);
-      }
-    }
+      // Same kernel, but for cut-cells.
+      auto irregularKernel = [&](const VolIndex& vof) -> void {
+        Real vel = 0.0;
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          vel += std::abs(velo(vof, dir));
+        }
 
-    // If we are using MPI then ranks need to know of each other's time steps.
-    minDt = ParallelOps::min(minDt);
+        minDt = std::min(dx / vel, minDt);
+      };
+
+      // Execute the kernels.
+      BoxLoops::loop(cellBox, regularKernel);
+      BoxLoops::loop(vofit, irregularKernel);
+    }
   }
 
   return minDt;
@@ -2596,7 +2900,7 @@ CdrSolver::weightedUpwind(EBAMRCellData& a_weightedUpwindPhi, const int a_pow)
 
     // Divide. Set to zero m_phi if there are no inflow faces.
     EBAMRCellData zero;
-    m_amr->allocate(zero, m_realm, m_phase, m_nComp);
+    m_amr->allocateScratch(zero, m_realm, m_phase, m_nComp);
     DataOps::setValue(zero, 0.0);
     DataOps::divideFallback(a_weightedUpwindPhi, m_scratch, zero);
 
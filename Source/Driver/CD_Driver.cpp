@@ -36,6 +36,7 @@
 #include <CD_Timer.H>
 #include <CD_ParallelOps.H>
 #include <CD_DischargeIO.H>
+#include <CD_TagMask.H>
 #include <CD_NamespaceHeader.H>
 
 Driver::Driver(const RefCountedPtr<ComputationalGeometry>& a_computationalGeometry,
@@ -65,7 +66,10 @@ Driver::Driver(const RefCountedPtr<ComputationalGeometry>& a_computationalGeomet
   m_dt       = 0.0;
 
   // Default is always to do the coarsening
-  m_doCoarsening = true;
+  m_doCoarsening       = true;
+  m_asyncPlotFiles     = false;
+  m_aggregatePlotFiles = false;
+  m_aggregationIgnored = false;
 
   // Parse some class options and create the output directories for the simulation.
   this->parseOptions();
@@ -314,6 +318,12 @@ Driver::getGeometryTags()
     m_geoCoarsen->coarsenTags(m_geomTags, m_amr->getDx(), m_amr->getProbLo());
   }
 
+  // Cache the tags as boxes, which is what tagCells passes into grid generation.
+  m_geomTagBoxes.resize(maxAmrDepth);
+  for (int lvl = 0; lvl < maxAmrDepth; lvl++) {
+    m_geomTagBoxes[lvl] = m_geomTags[lvl].boxes();
+  }
+
   // Processes may not agree what is the maximum tag depth. Make sure they're all on the same page.
   int deepestTagLevel = 0;
   for (int lvl = 0; lvl < m_geomTags.size(); lvl++) {
@@ -619,7 +629,7 @@ Driver::regrid(const int a_lmin, const int a_lmax, const bool a_useInitialData)
   // We are allowing geometric tags to change under the hood, but we need a method for detecting if they changed. If they did,
   // we certainly have to regrid.
   timer.startEvent("Get geometry tags");
-  Vector<IntVectSet> tags;
+  Vector<Vector<Box>> tags;
 
   if (m_needsNewGeometricTags) {
     this->getGeometryTags();
@@ -640,11 +650,6 @@ Driver::regrid(const int a_lmin, const int a_lmax, const bool a_useInitialData)
     }
     return;
   }
-  else { // Compact tags
-    for (int i = 0; i < tags.size(); i++) {
-      tags[i].compact();
-    }
-  }
 
   // Store things that need to be regridded
   timer.startEvent("Pre-regrid");
@@ -932,6 +937,9 @@ Driver::run(const Real a_startTime, const Real a_endTime, const int a_maxSteps)
     }
   }
 
+  // Complete any plot file that is still being written.
+  this->finishPlotFiles();
+
   if (m_verbosity > 0) {
     pout() << "==================================" << endl;
     pout() << "Driver::run -- ending run  " << endl;
@@ -1069,8 +1077,120 @@ Driver::parseOptions()
   this->parseGeometryRefinement();
   this->parseIrregTagGrowth();
 
-  // Not a required thing.
+  // Not required things.
   pp.query("coarsening", m_doCoarsening);
+
+  pp.query("async_plot", m_asyncPlotFiles);
+
+  this->parsePlotCompression();
+  this->parsePlotAggregation();
+}
+
+void
+Driver::parsePlotAggregation()
+{
+  CH_TIME("Driver::parsePlotAggregation()");
+  if (m_verbosity > 5) {
+    pout() << "Driver::parsePlotAggregation()" << endl;
+  }
+
+  ParmParse pp("Driver");
+
+  // Byte counts can exceed the range of int, so they are read as strings and converted to long long.
+  auto queryBytes = [&pp](const char* a_name, long long& a_bytes) -> void {
+    std::string str;
+    if (pp.query(a_name, str)) {
+      std::istringstream is(str);
+
+      long long bytes;
+      if (!(is >> bytes) || !(is >> std::ws).eof()) {
+        MayDay::Error(("Driver::parsePlotAggregation - could not read 'Driver." + std::string(a_name) + "'").c_str());
+      }
+
+      a_bytes = bytes;
+    }
+  };
+
+  int       numAggregators = m_plotAggregation.m_numAggregators;
+  long long chunkSize      = m_plotAggregation.m_chunkSize;
+  long long alignment      = m_plotAggregation.m_alignment;
+
+  pp.query("aggregate_plot", m_aggregatePlotFiles);
+  pp.query("plot_aggregators", numAggregators);
+  queryBytes("plot_chunk_size", chunkSize);
+  queryBytes("plot_alignment", alignment);
+
+  if (chunkSize <= 0) {
+    MayDay::Error("Driver::parsePlotAggregation - 'Driver.plot_chunk_size' must be > 0");
+  }
+
+  // Background writes use their own writer, so only compressed plot files go through the aggregated writer.
+  const bool isCompressed = m_plotCompression.m_precision != DischargeIO::Precision::Double ||
+                            m_plotCompression.m_compression != DischargeIO::Compression::None;
+
+  // This is also called when parsing runtime options, so only warn when the option is first ignored.
+  const bool isIgnored = m_aggregatePlotFiles && m_asyncPlotFiles && !isCompressed;
+
+  if (isIgnored && !m_aggregationIgnored && procID() == 0) {
+    MayDay::Warning("Driver::parsePlotAggregation - 'Driver.aggregate_plot' is ignored when 'Driver.async_plot' = true");
+  }
+
+  m_aggregationIgnored = isIgnored;
+
+  m_plotAggregation.m_numAggregators = numAggregators;
+  m_plotAggregation.m_chunkSize      = chunkSize;
+  m_plotAggregation.m_alignment      = alignment;
+}
+
+void
+Driver::parsePlotCompression()
+{
+  CH_TIME("Driver::parsePlotCompression()");
+  if (m_verbosity > 5) {
+    pout() << "Driver::parsePlotCompression()" << endl;
+  }
+
+  ParmParse pp("Driver");
+
+  std::string str;
+
+  if (pp.contains("plot_precision")) {
+    pp.get("plot_precision", str);
+
+    if (str == "double") {
+      m_plotCompression.m_precision = DischargeIO::Precision::Double;
+    }
+    else if (str == "single") {
+      m_plotCompression.m_precision = DischargeIO::Precision::Single;
+    }
+    else {
+      MayDay::Error("Driver::parsePlotCompression - expected 'double' or 'single' for 'Driver.plot_precision'");
+    }
+  }
+
+  if (pp.contains("plot_compression")) {
+    pp.get("plot_compression", str);
+
+    if (str == "none") {
+      m_plotCompression.m_compression = DischargeIO::Compression::None;
+    }
+    else if (str == "deflate") {
+      m_plotCompression.m_compression = DischargeIO::Compression::Deflate;
+    }
+    else if (str == "lossy") {
+      m_plotCompression.m_compression = DischargeIO::Compression::Lossy;
+    }
+    else {
+      MayDay::Error("Driver::parsePlotCompression - expected 'none', 'deflate', or 'lossy' for 'Driver.plot_compression'");
+    }
+  }
+
+  pp.query("plot_deflate_level", m_plotCompression.m_deflateLevel);
+  pp.query("plot_error_bound", m_plotCompression.m_errorBound);
+
+  if (m_plotCompression.m_errorBound < 0.0) {
+    MayDay::Error("Driver::parsePlotCompression - 'Driver.plot_error_bound' must be >= 0");
+  }
 }
 
 void
@@ -1095,7 +1215,10 @@ Driver::parseRuntimeOptions()
   pp.get("allow_coarsening", m_allowCoarsening);
   pp.get("max_steps", m_maxSteps);
   pp.get("stop_time", m_stopTime);
+  pp.query("async_plot", m_asyncPlotFiles);
 
+  this->parsePlotCompression();
+  this->parsePlotAggregation();
   this->parseGeometryRefinement();
   this->parsePlotVariables();
   this->parseIrregTagGrowth();
@@ -1832,7 +1955,7 @@ Driver::getFinestTagLevel(const EBAMRTags& a_cellTags) const
 }
 
 bool
-Driver::tagCells(Vector<IntVectSet>& a_allTags, EBAMRTags& a_cellTags)
+Driver::tagCells(Vector<Vector<Box>>& a_tagBoxes, EBAMRTags& a_cellTags)
 {
   CH_TIME("Driver::tagCells");
   if (m_verbosity > 5) {
@@ -1844,22 +1967,27 @@ Driver::tagCells(Vector<IntVectSet>& a_allTags, EBAMRTags& a_cellTags)
   // Note that when we regrid we add at most one level at a time. This means that if we have a
   // simulation with AMR depth l and we want to add a level l+1, we need tags on levels 0 through l.
   const int finestLevel = m_amr->getFinestLevel();
-  a_allTags.resize(1 + finestLevel, IntVectSet());
+  a_tagBoxes.resize(1 + finestLevel);
 
   if (!m_cellTagger.isNull()) {
     got_new_tags = m_cellTagger->tagCells(a_cellTags);
   }
 
-  // Gather tags from a_tags
+  const int buf = m_cellTagger.isNull() ? 0 : m_cellTagger->getBuffer();
+
+  // Grow the tags with the cell tagger buffer on each patch and turn them into boxes. This is done on bit-packed masks so we
+  // never have to go through an IntVectSet for the cell tags.
   for (int lvl = 0; lvl <= finestLevel; lvl++) {
+    a_tagBoxes[lvl].resize(0);
+
     for (DataIterator dit = a_cellTags[lvl]->dataIterator(); dit.ok(); ++dit) {
-      a_allTags[lvl] |= IntVectSet((*a_cellTags[lvl])[dit()]); // This should become a TreeIntVectSet
-    }
+      const DenseIntVectSet& cellTags = (*a_cellTags[lvl])[dit()];
 
-    // Grow tags with cell taggers buffer
-    if (!m_cellTagger.isNull()) {
-      const int buf = m_cellTagger->getBuffer();
-      a_allTags[lvl].grow(buf);
+      if (!cellTags.isEmpty()) {
+        TagMask tagMask(cellTags);
+        tagMask.grow(buf);
+        tagMask.getBoxes(a_tagBoxes[lvl]);
+      }
     }
   }
 
@@ -1868,7 +1996,7 @@ Driver::tagCells(Vector<IntVectSet>& a_allTags, EBAMRTags& a_cellTags)
   if (m_allowCoarsening) {
     for (int lvl = 0; lvl <= finestLevel; lvl++) {
       if (lvl <= tag_level) {
-        a_allTags[lvl] |= m_geomTags[lvl];
+        a_tagBoxes[lvl].append(m_geomTagBoxes[lvl]);
       }
     }
   }
@@ -1876,26 +2004,11 @@ Driver::tagCells(Vector<IntVectSet>& a_allTags, EBAMRTags& a_cellTags)
     // Loop only goes to the current finest level because we only add one level at a time
     for (int lvl = 0; lvl <= finestLevel; lvl++) {
       if (lvl < m_amr->getMaxAmrDepth()) { // Geometric tags don't exist on AmrMesh.m_maxAmrDepth
-        a_allTags[lvl] |= m_geomTags[lvl];
+        a_tagBoxes[lvl].append(m_geomTagBoxes[lvl]);
       }
     }
   }
 
-#if 0 // Debug - if this fails, you have tags on m_amr->m_maxAmrDepth and something has gone wrong. 
-  if(finestLevel == m_amr->getMaxAmrDepth()){
-    for (int lvl = 0; lvl <= finestLevel; lvl++){
-      pout() << "level = " << lvl << "\t num_pts = " << a_allTags[lvl].numPts() << endl;
-    }
-    CH_assert(a_allTags[finestLevel].isEmpty());
-  }
-#endif
-
-  // Get the total number of tags
-  Vector<int> num_local_tags(1 + finestLevel);
-  for (int lvl = 0; lvl <= finestLevel; lvl++) {
-    num_local_tags[lvl] = a_allTags[lvl].numPts();
-  }
-
   return got_new_tags;
 }
 
@@ -1919,6 +2032,15 @@ Driver::writeMemoryUsage()
   Vector<Real> unfreedMemory;
   MemoryReport::getMemoryUsage(peakMemory, unfreedMemory);
 
+  // Get the per-category memory. Each category has a current value and a high-water mark.
+  const std::vector<MemoryReport::Category>& categories = MemoryReport::Categories;
+
+  Vector<Vector<Real>> categoryMemory(categories.size());
+  Vector<Vector<Real>> categoryHighWater(categories.size());
+  for (int icat = 0; icat < categories.size(); icat++) {
+    MemoryReport::getCategoryMemoryUsage(categories[icat], categoryMemory[icat], categoryHighWater[icat]);
+  }
+
   // Begin writing output
   if (procID() == 0) {
     std::ofstream f;
@@ -1929,12 +2051,24 @@ Driver::writeMemoryUsage()
     f << std::left << std::setw(width) << "# MPI rank"
       << "\t" << std::left << std::setw(width) << "Peak memory"
       << "\t" << std::left << std::setw(width) << "Unfreed memory"
-      << "\t" << endl;
+      << "\t";
+    for (const auto& category : categories) {
+      const std::string name = MemoryReport::getCategoryName(category);
+
+      f << std::left << std::setw(width) << name << "\t" << std::left << std::setw(width) << name + " (max)"
+        << "\t";
+    }
+    f << endl;
 
     // Write memory
     for (int i = 0; i < numProc(); i++) {
       f << std::left << std::setw(width) << i << "\t" << std::left << std::setw(width) << peakMemory[i] << "\t"
-        << std::left << std::setw(width) << unfreedMemory[i] << "\t" << endl;
+        << std::left << std::setw(width) << unfreedMemory[i] << "\t";
+      for (int icat = 0; icat < categories.size(); icat++) {
+        f << std::left << std::setw(width) << categoryMemory[icat][i] << "\t" << std::left << std::setw(width)
+          << categoryHighWater[icat][i] << "\t";
+      }
+      f << endl;
     }
   }
 }
@@ -2087,7 +2221,20 @@ Driver::writePlotFile()
   string fname(file_char);
 
   // Write.
-  this->writePlotFile(fname);
+  this->writePlotFile(fname, m_asyncPlotFiles);
+}
+
+void
+Driver::finishPlotFiles()
+{
+  CH_TIME("Driver::finishPlotFiles()");
+  if (m_verbosity > 5) {
+    pout() << "Driver::finishPlotFiles()" << endl;
+  }
+
+#ifdef CH_USE_HDF5
+  m_asyncPlotWriter.finish();
+#endif
 }
 
 void
@@ -2159,11 +2306,11 @@ Driver::writeCrashFile()
 }
 
 void
-Driver::writePlotFile(const std::string a_filename)
+Driver::writePlotFile(const std::string a_filename, const bool a_async)
 {
-  CH_TIME("Driver::writePlotFile(string)");
+  CH_TIME("Driver::writePlotFile(string, bool)");
   if (m_verbosity > 3) {
-    pout() << "Driver::writePlotFile(string)" << endl;
+    pout() << "Driver::writePlotFile(string, bool)" << endl;
   }
 
   // TLDR: This is the main routine for writing plot files. It consists of a bit of code with two essential components:
@@ -2261,19 +2408,56 @@ Driver::writePlotFile(const std::string a_filename)
       pout() << "Driver::writePlotFile - writing plot file..." << endl;
     }
 
+    // Only one file is allowed to be open at a time, so complete any pending background write first.
+    this->finishPlotFiles();
+
+    // Reduced precision and compression is only supported by the aggregated writer.
+    const bool isCompressed = m_plotCompression.m_precision != DischargeIO::Precision::Double ||
+                              m_plotCompression.m_compression != DischargeIO::Compression::None;
+
     timer.startEvent("Write data");
-    DischargeIO::writeEBHDF5(a_filename,
-                             plotVariableNames,
-                             m_amr->getGrids(m_realm),
-                             output_ptr,
-                             m_amr->getDomains(),
-                             m_amr->getDx(),
-                             m_amr->getRefinementRatios(),
-                             m_dt,
-                             m_time,
-                             m_amr->getProbLo(),
-                             plot_depth + 1,
-                             m_numPlotGhost);
+    if (a_async && !isCompressed) {
+      m_asyncPlotWriter.writePlotFile(a_filename,
+                                      plotVariableNames,
+                                      m_amr->getGrids(m_realm),
+                                      output_ptr,
+                                      m_amr->getDomains(),
+                                      m_amr->getDx(),
+                                      m_amr->getRefinementRatios(),
+                                      m_dt,
+                                      m_time,
+                                      plot_depth + 1,
+                                      m_numPlotGhost);
+    }
+    else if (m_aggregatePlotFiles || isCompressed) {
+      DischargeIO::writeEBHDF5Aggregated(a_filename,
+                                         plotVariableNames,
+                                         m_amr->getGrids(m_realm),
+                                         output_ptr,
+                                         m_amr->getDomains(),
+                                         m_amr->getDx(),
+                                         m_amr->getRefinementRatios(),
+                                         m_dt,
+                                         m_time,
+                                         plot_depth + 1,
+                                         m_numPlotGhost,
+                                         m_plotAggregation,
+                                         m_plotCompression);
+    }
+    else {
+      DischargeIO::writeEBHDF5(a_filename,
+                               plotVariableNames,
+                               m_amr->getGrids(m_realm),
+                               output_ptr,
+                               m_amr->getDomains(),
+                               m_amr->getDx(),
+                               m_amr->getRefinementRatios(),
+                               m_dt,
+                               m_time,
+                               m_amr->getProbLo(),
+                               plot_depth + 1,
+                               m_numPlotGhost);
+    }
     timer.stopEvent("Write data");
 #endif
 
@@ -2416,6 +2600,9 @@ Driver::writeCheckpointFile()
   }
 
 #ifdef CH_USE_HDF5
+  // Can't have a plot file open in the background while we write the checkpoint file.
+  this->finishPlotFiles();
+
   const int finestLevel      = m_amr->getFinestLevel();
   int       finestCheckLevel = Min(m_maxCheckpointDepth, finestLevel);
   if (m_maxCheckpointDepth < 0) {
@@ -25,6 +25,7 @@
 #include <CD_DischargeIO.H>
 #include <CD_Units.H>
 #include <CD_BoxLoops.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr int FieldSolver::m_comp;
@@ -45,7 +46,7 @@ FieldSolver::FieldSolver()
   this->setDefaultDomainBcFunctions();
 }
 
-FieldSolver::~FieldSolver() {}
+FieldSolver::~FieldSolver() { MemoryReport::releaseMemory(this); }
 
 void
 FieldSolver::setDataLocation(const Location::Cell a_dataLocation)
@@ -131,6 +132,8 @@ FieldSolver::allocateInternals()
     pout() << "FieldSolver::allocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   m_amr->allocate(m_potential, m_realm, m_nComp);
   m_amr->allocate(m_rho, m_realm, m_nComp);
   m_amr->allocate(m_residue, m_realm, m_nComp);
@@ -366,6 +369,8 @@ FieldSolver::deallocateInternals()
     pout() << "FieldSolver::deallocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   m_amr->deallocate(m_potential);
   m_amr->deallocate(m_rho);
   m_amr->deallocate(m_residue);
@@ -23,6 +23,7 @@
 #include <CD_MFHelmholtzJumpBCFactory.H>
 #include <CD_MFHelmholtzSaturationChargeJumpBCFactory.H>
 #include <CD_Units.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr Real FieldSolverMultigrid::m_alpha;
@@ -220,6 +221,8 @@ FieldSolverMultigrid::allocateInternals()
     pout() << "FieldSolverMultigrid::allocateInternals()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   FieldSolver::allocateInternals();
 
   m_amr->allocate(m_zero, m_realm, m_nComp);
@@ -383,6 +386,8 @@ FieldSolverMultigrid::setupSolver()
     pout() << "FieldSolverMultigrid::setupSolver()" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Multigrid, this);
+
   this->setupHelmholtzFactory(); // Set up the operator factory
   this->setupMultigrid();        // Set up the AMR multigrid solver
 
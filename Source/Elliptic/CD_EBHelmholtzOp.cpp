@@ -208,6 +208,10 @@ EBHelmholtzOp::defineStencils()
   m_alphaDiagWeight.define(m_eblg.getDBL());
   m_betaDiagWeight.define(m_eblg.getDBL());
   m_relaxStencils.define(m_eblg.getDBL());
+  m_interiorBoxes.define(m_eblg.getDBL());
+  m_shellBoxes.define(m_eblg.getDBL());
+
+  m_exchangeCopier.exchangeDefine(m_eblg.getDBL(), m_ghostPhi);
 
   for (int dir = 0; dir < SpaceDim; dir++) {
     m_vofIterDomLo[dir].define(m_eblg.getDBL());
@@ -243,6 +247,28 @@ EBHelmholtzOp::defineStencils()
     const EBISBox& ebisbox = m_eblg.getEBISL()[dit()];
     const EBGraph& ebgraph = ebisbox.getEBGraph();
 
+    // Split the box into the interior cells where the regular stencil does not reach into the ghost cells, and a one-cell thick shell
+    // along the box boundary. The shell is peeled off one direction at a time so that the boxes don't overlap.
+    Box          interiorBox = cellBox;
+    Vector<Box>& shellBoxes  = m_shellBoxes[dit()];
+
+    shellBoxes.resize(0);
+    for (int dir = 0; dir < SpaceDim && !interiorBox.isEmpty(); dir++) {
+      Box loBox = interiorBox;
+      loBox.setBig(dir, interiorBox.smallEnd(dir));
+      shellBoxes.push_back(loBox);
+
+      if (interiorBox.size(dir) > 1) {
+        Box hiBox = interiorBox;
+        hiBox.setSmall(dir, interiorBox.bigEnd(dir));
+        shellBoxes.push_back(hiBox);
+      }
+
+      interiorBox.grow(dir, -1);
+    }
+
+    m_interiorBoxes[dit()] = interiorBox;
+
     const IntVectSet irregIVS = ebisbox.getIrregIVS(cellBox);
     const IntVectSet multiIVS = ebisbox.getMultiCells(cellBox);
 
@@ -421,10 +447,10 @@ EBHelmholtzOp::setAlphaAndBeta(const Real& a_alpha, const Real& a_beta)
   m_alpha = a_alpha;
   m_beta  = a_beta;
 
-  // When we change alpha and beta we need to recompute relaxation coefficients...
-  this->computeAlphaWeight();
+  // When we change alpha and beta we need to recompute relaxation coefficients. The alpha-weight only depends on the A-coefficient,
+  // and the aggregated stencils only store offsets into the data (alpha and beta are passed in when they are applied), so those
+  // are left alone.
   this->computeRelaxationCoefficient();
-  this->makeAggStencil();
 }
 
 void
@@ -781,16 +807,52 @@ EBHelmholtzOp::applyOp(LevelData<EBCellFAB>&             a_Lphi,
   // do a local copy, but that can end up being expensive since this is called on every relaxation.
   LevelData<EBCellFAB>& phi = (LevelData<EBCellFAB>&)a_phi;
 
-  phi.exchange();
+  const DisjointBoxLayout& dbl   = a_Lphi.disjointBoxLayout();
+  const EBISLayout&        ebisl = m_eblg.getEBISL();
 
-  if (m_hasCoar && !m_turnOffBCs) {
-    this->interpolateCF(phi, a_phiCoar, a_homogeneousCFBC);
+  if (phi.ghostVect() != m_ghostPhi) {
+    phi.exchange();
+
+    if (m_hasCoar && !m_turnOffBCs) {
+      this->interpolateCF(phi, a_phiCoar, a_homogeneousCFBC);
+    }
+
+    // Apply operator in each kernel.
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      this->applyOp(a_Lphi[dit()], phi[dit()], dbl[dit()], dit(), a_homogeneousPhysBC);
+    }
   }
+  else {
+    // Start the ghost cell exchange and apply the regular stencil in the cells that don't need ghost cells while the messages are
+    // in flight.
+    phi.exchangeBegin(m_exchangeCopier);
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      if (!ebisl[dit()].isAllCovered()) {
+        this->applyOpRegularKernel(a_Lphi[dit()], phi[dit()], m_interiorBoxes[dit()], dit());
+      }
+    }
+
+    phi.exchangeEnd();
+
+    if (m_hasCoar && !m_turnOffBCs) {
+      this->interpolateCF(phi, a_phiCoar, a_homogeneousCFBC);
+    }
+
+    // Now do the cells on the box boundaries, and then the cut-cells.
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      if (!ebisl[dit()].isAllCovered()) {
+        const Vector<Box>& shellBoxes = m_shellBoxes[dit()];
+
+        this->applyDomainFlux(phi[dit()], dbl[dit()], dit(), a_homogeneousPhysBC);
+
+        for (int ibox = 0; ibox < shellBoxes.size(); ibox++) {
+          this->applyOpRegularKernel(a_Lphi[dit()], phi[dit()], shellBoxes[ibox], dit());
+        }
 
-  // Apply operator in each kernel.
-  const DisjointBoxLayout& dbl = a_Lphi.disjointBoxLayout();
-  for (DataIterator dit(dbl); dit.ok(); ++dit) {
-    this->applyOp(a_Lphi[dit()], phi[dit()], dbl[dit()], dit(), a_homogeneousPhysBC);
+        this->applyOpIrregular(a_Lphi[dit()], phi[dit()], dbl[dit()], dit(), a_homogeneousPhysBC);
+      }
+    }
   }
 }
 
@@ -829,6 +891,17 @@ EBHelmholtzOp::applyOpRegular(EBCellFAB&       a_Lphi,
   // Fill a_phi such that centered differences pushes in the domain flux.
   this->applyDomainFlux(a_phi, a_cellBox, a_dit, a_homogeneousPhysBC);
 
+  this->applyOpRegularKernel(a_Lphi, a_phi, a_cellBox, a_dit);
+}
+
+void
+EBHelmholtzOp::applyOpRegularKernel(EBCellFAB&       a_Lphi,
+                                    const EBCellFAB& a_phi,
+                                    const Box&       a_computeBox,
+                                    const DataIndex& a_dit)
+{
+  CH_TIME("EBHelmholtzOp::applyOpRegularKernel(EBCellFAB, EBCellFAB, Box, DataIndex)");
+
   BaseFab<Real>&       Lphi = a_Lphi.getSingleValuedFAB();
   const BaseFab<Real>& phi  = a_phi.getSingleValuedFAB();
   const BaseFab<Real>& aco  = (*m_Acoef)[a_dit].getSingleValuedFAB();
@@ -857,7 +930,7 @@ EBHelmholtzOp::applyOpRegular(EBCellFAB&       a_Lphi,
   };
 
   // Launch the kernel.
-  BoxLoops::loop(a_cellBox, kernel);
+  BoxLoops::loop(a_computeBox, kernel);
 }
 
 void
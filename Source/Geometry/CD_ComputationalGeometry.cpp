@@ -155,6 +155,9 @@ ComputationalGeometry::buildGeometries(const ProblemDomain a_finestDomain,
 {
   CH_TIME("ComputationalGeometry::buildGeometries(ProblemDomain, RealVect, Real, int, int, int)");
 
+  // Memory allocated when building the EBIS is attributed to this geometry.
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::EBIS, this);
+
   // Set the default maximum number of EB ghosts that we will ever use. This is needed because ScanShop will look
   // through grown grid patches when it determines if a grid patch is irregular or not.
   m_maxGhostEB = a_maxGhostEB;
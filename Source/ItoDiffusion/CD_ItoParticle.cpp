@@ -80,11 +80,12 @@ ItoParticle::allocateRuntimeBuffers()
   m_runtimeScalars = nullptr;
   m_runtimeVectors = nullptr;
 
-  if (s_numRuntimeScalars >= 0) {
+  // Note: Don't allocate anything if there are no run-time variables -- zero-length allocations still cost us a heap block per particle.
+  if (s_numRuntimeScalars > 0) {
     m_runtimeScalars = new Real[s_numRuntimeScalars];
   }
 
-  if (s_numRuntimeVectors >= 0) {
+  if (s_numRuntimeVectors > 0) {
     m_runtimeVectors = new RealVect[s_numRuntimeVectors];
   }
 }
@@ -111,14 +112,13 @@ ItoParticle::operator!=(const ItoParticle& a_p) const
 int
 ItoParticle::size() const
 {
-  const int compileSize = BinItem::size() + sizeof(m_mass) + sizeof(m_velocity) + sizeof(m_diffusion) +
-                          sizeof(m_oldPosition) + sizeof(m_mobility) + sizeof(m_averageEnergy);
-  //  const int runtimeSize = sizeof(*m_runtimeScalars) + sizeof(*m_runtimeVectors);
+  const int compileSize = BinItem::size() + sizeof(m_mass) + sizeof(m_velocity) + sizeof(m_oldPosition);
   const int runtimeSize = s_numRuntimeScalars * sizeof(Real) + s_numRuntimeVectors * sizeof(RealVect);
 
-  //  std::cout << s_numRuntimeVectors*sizeof(RealVect) << std::endl;
+  // The auxiliary fields go at the end of the buffer. Pad them to a whole number of Reals so the next particle in the buffer is aligned.
+  const int auxSize = sizeof(Real) * ((3 * sizeof(AuxReal) + sizeof(Real) - 1) / sizeof(Real));
 
-  return compileSize + runtimeSize;
+  return compileSize + runtimeSize + auxSize;
 }
 
 void
@@ -138,9 +138,7 @@ ItoParticle::linearOut(void* buf) const
           , *buffer++ = m_oldPosition[4];
           , *buffer++ = m_oldPosition[5];);
 
-  *buffer++ = m_diffusion;
   *buffer++ = m_mass;
-  *buffer++ = m_mobility;
 
   // Go through run-time memory
   for (int i = 0; i < s_numRuntimeScalars; i++) {
@@ -155,7 +153,12 @@ ItoParticle::linearOut(void* buf) const
             , *buffer++                                    = m_runtimeVectors[i][5];);
   }
 
-  *buffer = m_averageEnergy;
+  // Auxiliary fields are written last since they might be stored with a different precision.
+  AuxReal* auxBuffer = (AuxReal*)buffer;
+
+  *auxBuffer++ = m_diffusion;
+  *auxBuffer++ = m_mobility;
+  *auxBuffer   = m_averageEnergy;
 }
 
 void
@@ -175,9 +178,7 @@ ItoParticle::linearIn(void* buf)
           , m_oldPosition[4] = *buffer++;
           , m_oldPosition[5] = *buffer++;);
 
-  m_diffusion = *buffer++;
-  m_mass      = *buffer++;
-  m_mobility  = *buffer++;
+  m_mass = *buffer++;
 
   // Go through run-time memory
   for (int i = 0; i < s_numRuntimeScalars; i++) {
@@ -191,7 +192,11 @@ ItoParticle::linearIn(void* buf)
             , m_runtimeVectors[i][5]                                    = *buffer++;);
   }
 
-  m_averageEnergy = *buffer;
+  const AuxReal* auxBuffer = (AuxReal*)buffer;
+
+  m_diffusion     = *auxBuffer++;
+  m_mobility      = *auxBuffer++;
+  m_averageEnergy = *auxBuffer;
 }
 
 std::ostream&
@@ -24,6 +24,8 @@
 #include <CD_ParticleOps.H>
 #include <CD_BoxLoops.H>
 #include <CD_Random.H>
+#include <CD_MemoryReport.H>
+#include <CD_DischargeIO.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr int ItoSolver::m_comp;
@@ -43,7 +45,12 @@ ItoSolver::ItoSolver()
   m_mobilityInterp = WhichMobilityInterpolation::Direct;
 }
 
-ItoSolver::~ItoSolver() { CH_TIME("ItoSolver::~ItoSolver"); }
+ItoSolver::~ItoSolver()
+{
+  CH_TIME("ItoSolver::~ItoSolver");
+
+  MemoryReport::releaseMemory(this);
+}
 
 std::string
 ItoSolver::getName() const
@@ -132,6 +139,29 @@ ItoSolver::parseSuperParticles()
   pp.get("kd_direction", m_directionKD);
 
   m_directionKD = std::min(m_directionKD, SpaceDim - 1);
+
+  // Not required -- defaults to always rebalancing with the BVH.
+  std::string str = "bvh";
+
+  m_mergeBand  = 1.0;
+  m_mergeCheck = false;
+
+  pp.query("merge_algorithm", str);
+  pp.query("merge_band", m_mergeBand);
+  pp.query("merge_check", m_mergeCheck);
+
+  if (str == "bvh") {
+    m_mergeAlgorithm = WhichMergeAlgorithm::BVH;
+  }
+  else if (str == "pairwise") {
+    m_mergeAlgorithm = WhichMergeAlgorithm::Pairwise;
+  }
+  else if (str == "reservoir") {
+    m_mergeAlgorithm = WhichMergeAlgorithm::Reservoir;
+  }
+  else {
+    MayDay::Abort("ItoSolver::parseSuperParticles - unknown merge algorithm requested");
+  }
 }
 
 void
@@ -356,6 +386,9 @@ ItoSolver::parseCheckpointing()
   else if (str == "numbers") {
     m_checkpointing = WhichCheckpoint::Numbers;
   }
+  else if (str == "blocks") {
+    m_checkpointing = WhichCheckpoint::Blocks;
+  }
   else {
     MayDay::Abort("ItoSolver::parseCheckpointing - unknown checkpointing method requested");
   }
@@ -903,6 +936,8 @@ ItoSolver::allocateInternals()
     pout() << m_name + "::allocateInternals" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   CH_assert(!m_species.isNull());
 
   const int ncomp = 1;
@@ -971,6 +1006,9 @@ ItoSolver::writeCheckpointLevel(HDF5Handle& a_handle, const int a_level) const
   case WhichCheckpoint::Numbers:
     this->writeCheckPointLevelFluid(a_handle, a_level);
     break;
+  case WhichCheckpoint::Blocks:
+    this->writeCheckPointLevelBlocks(a_handle, a_level);
+    break;
   default:
     MayDay::Error("ItoSolver::writeCheckpointLevel -- logic bust");
   }
@@ -1082,6 +1120,49 @@ ItoSolver::writeCheckPointLevelFluid(HDF5Handle& a_handle, const int a_level) co
 }
 #endif
 
+#ifdef CH_USE_HDF5
+void
+ItoSolver::writeCheckPointLevelBlocks(HDF5Handle& a_handle, const int a_level) const
+{
+  CH_TIME("ItoSolver::writeCheckPointLevelBlocks");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::writeCheckPointLevelBlocks" << endl;
+  }
+
+  // TLDR: This writes the same fields as writeCheckPointLevelParticles, i.e. position, mass, and energy. But rather than going through
+  //       Chombo's particle IO we flatten the particles and let DischargeIO write them as one contiguous block per rank.
+
+  constexpr int numFields = SpaceDim + 2;
+
+  const std::string str = m_name + "_particlesB";
+
+  const DisjointBoxLayout&              dbl         = m_amr->getGrids(m_realm)[a_level];
+  const ParticleContainer<ItoParticle>& myParticles = this->getParticles(WhichContainer::Bulk);
+
+  LayoutData<std::vector<Real>> particleFields(dbl);
+
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    const List<ItoParticle>& patchParticles = myParticles[a_level][dit()].listItems();
+
+    std::vector<Real>& fields = particleFields[dit()];
+
+    fields.reserve(numFields * patchParticles.length());
+
+    for (ListIterator<ItoParticle> lit(patchParticles); lit.ok(); ++lit) {
+      const ItoParticle& p = lit();
+
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        fields.emplace_back(p.position()[dir]);
+      }
+      fields.emplace_back(p.mass());
+      fields.emplace_back(p.energy());
+    }
+  }
+
+  DischargeIO::writeParticleBlocks(a_handle, str, dbl, particleFields, numFields);
+}
+#endif
+
 #ifdef CH_USE_HDF5
 void
 ItoSolver::readCheckpointLevel(HDF5Handle& a_handle, const int a_level)
@@ -1102,6 +1183,9 @@ ItoSolver::readCheckpointLevel(HDF5Handle& a_handle, const int a_level)
   case WhichCheckpoint::Numbers:
     this->readCheckpointLevelFluid(a_handle, a_level);
     break;
+  case WhichCheckpoint::Blocks:
+    this->readCheckpointLevelBlocks(a_handle, a_level);
+    break;
   default:
     MayDay::Error("ItoSolver::readCheckpointLevel -- logic bust");
   }
@@ -1155,6 +1239,58 @@ ItoSolver::readCheckpointLevelParticles(HDF5Handle& a_handle, const int a_level)
 }
 #endif
 
+#ifdef CH_USE_HDF5
+void
+ItoSolver::readCheckpointLevelBlocks(HDF5Handle& a_handle, const int a_level)
+{
+  CH_TIME("ItoSolver::readCheckpointLevelBlocks");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::readCheckpointLevelBlocks" << endl;
+  }
+
+  // This is the particle container that we will fill.
+  ParticleContainer<ItoParticle>& particles = m_particleContainers.at(WhichContainer::Bulk);
+
+  CH_assert(m_checkpointing == WhichCheckpoint::Blocks);
+  CH_assert(!particles.isCellSorted());
+
+  constexpr int numFields = SpaceDim + 2;
+
+  const std::string str = m_name + "_particlesB";
+
+  const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[a_level];
+
+  // Read the particle fields that fall inside the boxes on this rank.
+  LayoutData<std::vector<Real>> particleFields(dbl);
+
+  DischargeIO::readParticleBlocks(a_handle,
+                                  str,
+                                  dbl,
+                                  m_amr->getProbLo(),
+                                  m_amr->getDx()[a_level],
+                                  particleFields,
+                                  numFields);
+
+  // Make the fields into true ItoParticles.
+  for (DataIterator dit(dbl); dit.ok(); ++dit) {
+    List<ItoParticle>&       itoParticles = particles[a_level][dit()].listItems();
+    const std::vector<Real>& fields       = particleFields[dit()];
+
+    for (size_t i = 0; i < fields.size(); i += numFields) {
+      RealVect position;
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        position[dir] = fields[i + dir];
+      }
+
+      const Real mass   = fields[i + SpaceDim];
+      const Real energy = fields[i + SpaceDim + 1];
+
+      itoParticles.append(ItoParticle(mass, position, RealVect::Zero, 0.0, 0.0, energy));
+    }
+  }
+}
+#endif
+
 #ifdef CH_USE_HDF5
 void
 ItoSolver::readCheckpointLevelFluid(HDF5Handle& a_handle, const int a_level)
@@ -2996,12 +3132,76 @@ ItoSolver::makeSuperparticles(const WhichContainer a_container,
   ParticleContainer<ItoParticle>& particles     = this->getParticles(a_container);
   BinFab<ItoParticle>&            cellParticles = particles.getCellParticles(a_level, a_dit);
 
+  // Cells are only rebalanced if the number of particles is outside the hysteresis band.
+  const bool useBand      = m_mergeBand > 1.0;
+  const Real minParticles = a_particlesPerCell / m_mergeBand;
+  const Real maxParticles = a_particlesPerCell * m_mergeBand;
+
+  // Total mass and energy in a list of particles.
+  auto massAndEnergy = [](const List<ItoParticle>& a_particles, Real& a_mass, Real& a_energy) -> void {
+    a_mass   = 0.0;
+    a_energy = 0.0;
+
+    for (ListIterator<ItoParticle> lit(a_particles); lit.ok(); ++lit) {
+      a_mass += lit().mass();
+      a_energy += lit().mass() * lit().energy();
+    }
+  };
+
   // Kernel for particle merging.
   auto kernel = [&](const IntVect& iv) -> void {
     List<ItoParticle>& particles = cellParticles(iv, m_comp);
 
-    if (particles.length() > 0) {
-      this->mergeBVH(particles, a_particlesPerCell);
+    const int numParticles = particles.length();
+
+    if (numParticles > 0) {
+      if (!useBand || numParticles < minParticles || numParticles > maxParticles) {
+        Real massBefore   = 0.0;
+        Real energyBefore = 0.0;
+
+        if (m_mergeCheck) {
+          massAndEnergy(particles, massBefore, energyBefore);
+        }
+
+        switch (m_mergeAlgorithm) {
+        case WhichMergeAlgorithm::BVH: {
+          this->mergeBVH(particles, a_particlesPerCell);
+
+          break;
+        }
+        case WhichMergeAlgorithm::Pairwise: {
+          this->mergePairwise(particles, a_particlesPerCell);
+
+          break;
+        }
+        case WhichMergeAlgorithm::Reservoir: {
+          this->mergeReservoir(particles, a_particlesPerCell);
+
+          break;
+        }
+        default: {
+          MayDay::Error("ItoSolver::makeSuperparticles - logic bust");
+
+          break;
+        }
+        }
+
+        if (m_mergeCheck) {
+          Real massAfter   = 0.0;
+          Real energyAfter = 0.0;
+
+          massAndEnergy(particles, massAfter, energyAfter);
+
+          constexpr Real tolerance = 1.E-10;
+
+          if (std::abs(massAfter - massBefore) > tolerance * massBefore) {
+            MayDay::Error("ItoSolver::makeSuperparticles - merging did not conserve mass");
+          }
+          if (std::abs(energyAfter - energyBefore) > tolerance * std::abs(energyBefore)) {
+            MayDay::Error("ItoSolver::makeSuperparticles - merging did not conserve energy");
+          }
+        }
+      }
     }
   };
 
@@ -3020,34 +3220,242 @@ ItoSolver::mergeBVH(List<ItoParticle>& a_particles, const int a_particlesPerCell
     pout() << m_name + "::mergeBVH" << endl;
   }
 
-  // 1. Make ItoParticle into point masses.
-  std::vector<PointMass> pointMasses(0);
+  // 1. Make ItoParticle into point masses. The tree storage is reused between cells so this does not allocate once the
+  //    tree has seen a large enough cell.
+  std::vector<PointMass>& pointMasses = m_mergeTree.getPoints();
+
+  pointMasses.clear();
   for (ListIterator<ItoParticle> lit(a_particles); lit.ok(); ++lit) {
     const ItoParticle& p = lit();
 
-    pointMasses.push_back(PointMass(p.position(), p.mass(), p.energy()));
+    pointMasses.emplace_back(p.position(), p.mass(), p.energy());
   }
 
   // 2. Build the BVH tree and get the leaves of the tree
   const int firstDir = (m_directionKD < 0) ? Random::get(m_uniformDistribution0d) : m_directionKD;
-  m_mergeTree.define(pointMasses);
-  m_mergeTree.buildTree(firstDir, a_particlesPerCell, ItoMerge::NodePartitionEqualMass<PointMass>);
+  m_mergeTree.buildTree(firstDir, a_particlesPerCell);
 
   // 3. Go through the leaves in the tree -- each leaf has a set of PointMass'es that we make into a single
   //    computational particle.
   a_particles.clear();
-  const auto& leaves = m_mergeTree.getLeaves();
-  for (const auto& leaf : leaves) {
+  for (const auto& leaf : m_mergeTree.getLeaves()) {
 
     // Merge all the point-masses in the leaf into a single point mass.
-    const PointMass pointMass(leaf->getData());
+    RealVect pos    = RealVect::Zero;
+    Real     energy = 0.0;
+
+    for (int i = leaf.m_begin; i < leaf.m_end; i++) {
+      const PointMass& pointMass = pointMasses[i];
+
+      pos += pointMass.mass() * pointMass.pos();
+      energy += pointMass.mass() * pointMass.energy();
+    }
+
+    pos /= leaf.m_mass;
+    energy /= leaf.m_mass;
 
     // Make the single point mass into an ItoParticle and add it back in.
-    ItoParticle p(pointMass.mass(), pointMass.pos(), RealVect::Zero, 0.0, 0.0, pointMass.energy());
+    ItoParticle p(leaf.m_mass, pos, RealVect::Zero, 0.0, 0.0, energy);
     a_particles.add(p);
   }
 }
 
+void
+ItoSolver::mergePairwise(List<ItoParticle>& a_particles, const int a_particlesPerCell)
+{
+  CH_TIME("ItoSolver::mergePairwise");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::mergePairwise" << endl;
+  }
+
+  this->loadMergeParticles(a_particles);
+
+  std::vector<MergeParticle>& particles = m_mergeParticles;
+
+  auto heavier = [](const MergeParticle& a, const MergeParticle& b) -> bool {
+    return a.m_mass < b.m_mass;
+  };
+
+  if (static_cast<int>(particles.size()) < a_particlesPerCell) {
+    // Too few particles -- split the heaviest particles in two (in whole physical particles) until we have enough particles or
+    // none of them can be split.
+    std::make_heap(particles.begin(), particles.end(), heavier);
+
+    while (static_cast<int>(particles.size()) < a_particlesPerCell && particles.front().m_mass >= 2.0) {
+      std::pop_heap(particles.begin(), particles.end(), heavier);
+
+      MergeParticle& p = particles.back();
+
+      const Real halfMass = std::floor(0.5 * p.m_mass);
+
+      MergeParticle q = p;
+
+      p.m_mass -= halfMass;
+      q.m_mass = halfMass;
+
+      std::push_heap(particles.begin(), particles.end(), heavier);
+
+      particles.emplace_back(q);
+      std::push_heap(particles.begin(), particles.end(), heavier);
+    }
+  }
+  else {
+    // Too many particles. Sort the particles along the velocity component with the largest spread and merge adjacent pairs
+    // with the smallest velocity difference. Each pass can at most halve the number of particles, so we may need a few passes.
+    while (static_cast<int>(particles.size()) > a_particlesPerCell) {
+      RealVect minVel = particles.front().m_vel;
+      RealVect maxVel = particles.front().m_vel;
+
+      for (const auto& p : particles) {
+        minVel = min(minVel, p.m_vel);
+        maxVel = max(maxVel, p.m_vel);
+      }
+
+      const RealVect spread = maxVel - minVel;
+
+      int sortDir = 0;
+      for (int dir = 1; dir < SpaceDim; dir++) {
+        sortDir = (spread[dir] > spread[sortDir]) ? dir : sortDir;
+      }
+
+      std::sort(particles.begin(), particles.end(), [sortDir](const MergeParticle& a, const MergeParticle& b) -> bool {
+        return a.m_vel[sortDir] < b.m_vel[sortDir];
+      });
+
+      const int numPairs  = particles.size() / 2;
+      const int numMerges = std::min(numPairs, static_cast<int>(particles.size()) - a_particlesPerCell);
+
+      m_mergePairs.clear();
+      for (int i = 0; i < numPairs; i++) {
+        m_mergePairs.emplace_back((particles[2 * i + 1].m_vel - particles[2 * i].m_vel).vectorLength(), i);
+      }
+
+      if (numMerges < numPairs) {
+        std::nth_element(m_mergePairs.begin(), m_mergePairs.begin() + numMerges, m_mergePairs.end());
+      }
+
+      // Merge the selected pairs into the first particle in the pair and flag the second one for removal. This conserves mass,
+      // momentum, and energy.
+      for (int i = 0; i < numMerges; i++) {
+        MergeParticle& p = particles[2 * m_mergePairs[i].second];
+        MergeParticle& q = particles[2 * m_mergePairs[i].second + 1];
+        const Real     m = p.m_mass + q.m_mass;
+
+        p.m_pos    = (p.m_mass * p.m_pos + q.m_mass * q.m_pos) / m;
+        p.m_vel    = (p.m_mass * p.m_vel + q.m_mass * q.m_vel) / m;
+        p.m_energy = (p.m_mass * p.m_energy + q.m_mass * q.m_energy) / m;
+        p.m_mass   = m;
+
+        q.m_mass = 0.0;
+      }
+
+      particles.erase(std::remove_if(particles.begin(),
+                                     particles.end(),
+                                     [](const MergeParticle& p) -> bool { return p.m_mass <= 0.0; }),
+                      particles.end());
+    }
+  }
+
+  this->storeMergeParticles(a_particles);
+}
+
+void
+ItoSolver::mergeReservoir(List<ItoParticle>& a_particles, const int a_particlesPerCell)
+{
+  CH_TIME("ItoSolver::mergeReservoir");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::mergeReservoir" << endl;
+  }
+
+  this->loadMergeParticles(a_particles);
+
+  // TLDR: This is systematic resampling. We lay out the particles along a line where each particle occupies a length equal to
+  //       its weight, and put N equally spaced sampling points (with a random offset) along the line. Each sampling point
+  //       becomes a new particle with weight M/N at the position of the particle it landed in. Heavy particles are
+  //       thus resampled into several particles and light particles are either dropped or promoted to a full weight.
+
+  Real totalMass   = 0.0;
+  Real totalEnergy = 0.0;
+  for (const auto& p : m_mergeParticles) {
+    totalMass += p.m_mass;
+    totalEnergy += p.m_mass * p.m_energy;
+  }
+
+  // Don't make particles that are lighter than one physical particle.
+  const long long maxNew = llround(std::floor(totalMass));
+  const long long numNew = std::max(1LL, std::min(static_cast<long long>(a_particlesPerCell), maxNew));
+  const Real      weight = totalMass / numNew;
+  const Real      offset = weight * Random::getUniformReal01();
+
+  a_particles.clear();
+
+  Real      newEnergy  = 0.0;
+  Real      cumulative = 0.0;
+  long long numDrawn   = 0LL;
+
+  for (const auto& p : m_mergeParticles) {
+    const Real lo = cumulative;
+
+    cumulative += p.m_mass;
+
+    // Number of sampling points in [lo, cumulative). The last particle takes whatever is left over due to round-off.
+    const long long last = (&p == &m_mergeParticles.back())
+                             ? numNew
+                             : std::min(numNew, static_cast<long long>(std::ceil((cumulative - offset) / weight)));
+    const long long first = std::min(last, static_cast<long long>(std::ceil((lo - offset) / weight)));
+
+    for (long long i = std::max(first, numDrawn); i < last; i++) {
+      a_particles.add(ItoParticle(weight, p.m_pos, p.m_vel, 0.0, 0.0, p.m_energy));
+
+      newEnergy += weight * p.m_energy;
+    }
+
+    numDrawn = std::max(numDrawn, last);
+  }
+
+  // Rescale the energies so that the total energy is conserved.
+  if (newEnergy > 0.0) {
+    const Real factor = totalEnergy / newEnergy;
+
+    for (ListIterator<ItoParticle> lit(a_particles); lit.ok(); ++lit) {
+      lit().energy() *= factor;
+    }
+  }
+}
+
+void
+ItoSolver::loadMergeParticles(const List<ItoParticle>& a_particles)
+{
+  CH_TIME("ItoSolver::loadMergeParticles");
+
+  m_mergeParticles.clear();
+
+  for (ListIterator<ItoParticle> lit(a_particles); lit.ok(); ++lit) {
+    const ItoParticle& p = lit();
+
+    MergeParticle mergeParticle;
+
+    mergeParticle.m_pos    = p.position();
+    mergeParticle.m_vel    = p.velocity();
+    mergeParticle.m_mass   = p.mass();
+    mergeParticle.m_energy = p.energy();
+
+    m_mergeParticles.emplace_back(mergeParticle);
+  }
+}
+
+void
+ItoSolver::storeMergeParticles(List<ItoParticle>& a_particles) const
+{
+  CH_TIME("ItoSolver::storeMergeParticles");
+
+  a_particles.clear();
+
+  for (const auto& p : m_mergeParticles) {
+    a_particles.add(ItoParticle(p.m_mass, p.m_pos, p.m_vel, 0.0, 0.0, p.m_energy));
+  }
+}
+
 void
 ItoSolver::clear(const WhichContainer a_container)
 {
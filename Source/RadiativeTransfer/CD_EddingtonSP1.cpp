@@ -27,11 +27,15 @@
 #include <CD_EBHelmholtzNeumannEBBCFactory.H>
 #include <CD_EBHelmholtzLarsenEBBCFactory.H>
 #include <CD_EBHelmholtzEddingtonSP1DomainBCFactory.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr Real EddingtonSP1::m_alpha;
 constexpr Real EddingtonSP1::m_beta;
 
+std::map<std::string, std::weak_ptr<EddingtonSP1::HelmholtzCoefficients>> EddingtonSP1::s_sharedCoefficients;
+std::map<std::string, std::weak_ptr<EddingtonSP1::SharedSolver>>          EddingtonSP1::s_sharedSolvers;
+
 Real
 EddingtonSP1::s_defaultDomainBcFunction(const RealVect a_position, const Real a_time)
 {
@@ -45,16 +49,29 @@ EddingtonSP1::EddingtonSP1() : RtSolver()
   m_name      = "EddingtonSP1";
   m_className = "EddingtonSP1";
 
-  m_verbosity     = -1;
-  m_isSolverSetup = false;
-  m_dataLocation  = Location::Cell::Center;
-  m_regridSlopes  = true;
+  m_verbosity            = -1;
+  m_isSolverSetup        = false;
+  m_dataLocation         = Location::Cell::Center;
+  m_regridSlopes         = true;
+  m_sharedSolverVersion  = -1;
+  m_hasCustomBcFunctions = false;
 
   this
     ->setDefaultDomainBcFunctions(); // This fills m_domainBcFunctions with s_defaultDomainBcFunction on every domain side.
 }
 
-EddingtonSP1::~EddingtonSP1() {}
+EddingtonSP1::~EddingtonSP1()
+{
+  // The boundary conditions and bottom solver in the shared multigrid solver belong to the instance that set it up. If that is
+  // us, invalidate the solver so that the other instances set up a new one.
+  if (m_sharedSolver && m_sharedSolver->m_owner == this) {
+    m_sharedSolver->m_owner = nullptr;
+    m_sharedSolver->m_grids.resize(0);
+    m_sharedSolver->m_multigridSolver    = RefCountedPtr<AMRMultiGrid<LevelData<EBCellFAB>>>();
+    m_sharedSolver->m_helmholtzOpFactory = RefCountedPtr<EBHelmholtzOpFactory>();
+    m_sharedSolver->m_version++;
+  }
+}
 
 void
 EddingtonSP1::parseOptions()
@@ -117,6 +134,8 @@ EddingtonSP1::setDomainSideBcFunction(const int                               a_
   const EddingtonSP1DomainBc::DomainSide domainSide = std::make_pair(a_dir, a_side);
 
   m_domainBcFunctions.at(domainSide) = a_function;
+
+  m_hasCustomBcFunctions = true;
 }
 
 std::string
@@ -493,9 +512,8 @@ EddingtonSP1::allocateInternals()
     pout() << m_name + "::allocateInternals" << endl;
   }
 
-  m_amr->allocate(m_helmAco, m_realm, m_phase, m_nComp);
-  m_amr->allocate(m_helmBco, m_realm, m_phase, m_nComp);
-  m_amr->allocate(m_helmBcoIrreg, m_realm, m_phase, m_nComp);
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   m_amr->allocate(m_phi, m_realm, m_phase, m_nComp);
   m_amr->allocate(m_source, m_realm, m_phase, m_nComp);
   m_amr->allocate(m_resid, m_realm, m_phase, m_nComp);
@@ -508,15 +526,21 @@ EddingtonSP1::allocateInternals()
   DataOps::setValue(m_zero, 0.0);
   DataOps::setValue(m_scaledSource, 0.0);
 
+  // Only fills the coefficients on grid levels that changed.
   this->setHelmholtzCoefficients();
 }
 
 void
 EddingtonSP1::deallocateInternals()
 {
-  m_amr->deallocate(m_helmAco);
-  m_amr->deallocate(m_helmBco);
-  m_amr->deallocate(m_helmBcoIrreg);
+  {
+    MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Multigrid, this);
+
+    m_helmholtzCoefficients.reset();
+  }
+
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   m_amr->deallocate(m_phi);
   m_amr->deallocate(m_source);
   m_amr->deallocate(m_resid);
@@ -590,10 +614,17 @@ EddingtonSP1::advance(const Real a_dt, EBAMRCellData& a_phi, const EBAMRCellData
 
   bool converged = false;
 
-  if (!m_isSolverSetup) {
+  // If we share the multigrid solver with other instances, it might have been set up again by one of them (e.g. after regrids).
+  const bool sharedSolverChanged = m_sharedSolver && (m_sharedSolver->m_version != m_sharedSolverVersion);
+
+  if (!m_isSolverSetup || sharedSolverChanged) {
     this->setupSolver();
   }
 
+  if (m_sharedSolver) {
+    this->resetAlphaAndBeta();
+  }
+
   // Modify the source term.  Operator is scaled by kappa and source term might also have to be scaled by kappa
   DataOps::copy(m_scaledSource, a_source); // Copy source term
   DataOps::scale(m_scaledSource,
@@ -667,9 +698,58 @@ EddingtonSP1::setupSolver()
     pout() << m_name + "::setupSolver" << endl;
   }
 
-  this->setHelmholtzCoefficients(); // Set coefficients, kappa, aco, bco
-  this->setupHelmholtzFactory();    // Set up the Helmholtz operator factory
-  this->setupMultigrid();           // Set up the AMR multigrid solver
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Multigrid, this);
+
+  this->setHelmholtzCoefficients(); // Set coefficients, kappa, aco, bco. Does nothing if they are already up to date.
+
+  if (this->canShareSolver()) {
+    const std::string key = this->getSharingKey();
+
+    std::shared_ptr<SharedSolver> sharedSolver = s_sharedSolvers[key].lock();
+    if (!sharedSolver) {
+      sharedSolver            = std::make_shared<SharedSolver>();
+      sharedSolver->m_owner   = nullptr;
+      sharedSolver->m_version = 0;
+      sharedSolver->m_alpha   = 0.0;
+      sharedSolver->m_beta    = 0.0;
+
+      s_sharedSolvers[key] = sharedSolver;
+    }
+
+    // Check if the shared solver was set up on the current grids.
+    const Vector<DisjointBoxLayout>& grids = m_amr->getGrids(m_realm);
+
+    bool isCurrent = !(sharedSolver->m_multigridSolver.isNull()) && (sharedSolver->m_grids.size() == grids.size());
+    for (int lvl = 0; lvl < grids.size() && isCurrent; lvl++) {
+      isCurrent = (grids[lvl] == sharedSolver->m_grids[lvl]);
+    }
+
+    if (isCurrent) {
+      m_helmholtzOpFactory = sharedSolver->m_helmholtzOpFactory;
+      m_multigridSolver    = sharedSolver->m_multigridSolver;
+    }
+    else {
+      this->setupHelmholtzFactory(); // Set up the Helmholtz operator factory
+      this->setupMultigrid();        // Set up the AMR multigrid solver
+
+      sharedSolver->m_owner              = this;
+      sharedSolver->m_grids              = grids;
+      sharedSolver->m_alpha              = this->getHelmholtzAlpha();
+      sharedSolver->m_beta               = this->getHelmholtzBeta();
+      sharedSolver->m_helmholtzOpFactory = m_helmholtzOpFactory;
+      sharedSolver->m_multigridSolver    = m_multigridSolver;
+      sharedSolver->m_version++;
+    }
+
+    m_sharedSolver        = sharedSolver;
+    m_sharedSolverVersion = sharedSolver->m_version;
+  }
+  else {
+    m_sharedSolver.reset();
+
+    this->setupHelmholtzFactory(); // Set up the Helmholtz operator factory
+    this->setupMultigrid();        // Set up the AMR multigrid solver
+  }
 
   if (!m_stationary) {
     if (m_useTGA) {
@@ -691,19 +771,187 @@ EddingtonSP1::setHelmholtzCoefficients()
     pout() << m_name + "::setHelmholtzCoefficients" << endl;
   }
 
-  // This loop fills aco with kappa and bco_irreg with 1./kappa
-  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[lvl];
+  // TLDR: If the absorption coefficient is constant we use A = B = 1 and put kappa in alpha and beta instead. These coefficients
+  //       are the same for all species so they are shared between all instances on this realm and phase. Otherwise we use
+  //       our own coefficients A = kappa and B = 1/(3*kappa). In both cases we only fill the grid levels that changed since
+  //       the coefficients were last set.
+  const bool unitCoefficients = this->useUnitCoefficients();
+
+  if (unitCoefficients) {
+    const std::string key = this->getSharingKey();
+
+    m_helmholtzCoefficients = s_sharedCoefficients[key].lock();
+
+    if (!m_helmholtzCoefficients) {
+      m_helmholtzCoefficients                     = std::make_shared<HelmholtzCoefficients>();
+      m_helmholtzCoefficients->m_unitCoefficients = true;
+
+      s_sharedCoefficients[key] = m_helmholtzCoefficients;
+    }
+  }
+  else if (!m_helmholtzCoefficients || m_helmholtzCoefficients->m_unitCoefficients) {
+    m_helmholtzCoefficients                     = std::make_shared<HelmholtzCoefficients>();
+    m_helmholtzCoefficients->m_unitCoefficients = false;
+  }
+
+  HelmholtzCoefficients& coeffs = *m_helmholtzCoefficients;
+
+  const Vector<DisjointBoxLayout>& grids       = m_amr->getGrids(m_realm);
+  const int                        finestLevel = m_amr->getFinestLevel();
+
+  // Find the coarsest grid level that changed since the coefficients were set. AmrMesh keeps the grids on levels that did not
+  // change during regrids.
+  int lmin = 0;
+  while (lmin <= finestLevel && lmin < coeffs.m_grids.size() && grids[lmin] == coeffs.m_grids[lmin]) {
+    lmin++;
+  }
+
+  if (lmin > finestLevel && coeffs.m_grids.size() == 1 + finestLevel) {
+    return;
+  }
+
+  if (coeffs.m_grids.size() == 0) {
+    m_amr->allocate(coeffs.m_helmAco, m_realm, m_phase, m_nComp);
+    m_amr->allocate(coeffs.m_helmBco, m_realm, m_phase, m_nComp);
+    m_amr->allocate(coeffs.m_helmBcoIrreg, m_realm, m_phase, m_nComp);
+  }
+  else {
+    m_amr->reallocate(coeffs.m_helmAco, m_phase, lmin);
+    m_amr->reallocate(coeffs.m_helmBco, m_phase, lmin);
+    m_amr->reallocate(coeffs.m_helmBcoIrreg, m_phase, lmin);
+  }
+
+  for (int lvl = lmin; lvl <= finestLevel; lvl++) {
+    LevelData<EBCellFAB>&       helmAco      = *coeffs.m_helmAco[lvl];
+    LevelData<EBFluxFAB>&       helmBco      = *coeffs.m_helmBco[lvl];
+    LevelData<BaseIVFAB<Real>>& helmBcoIrreg = *coeffs.m_helmBcoIrreg[lvl];
+
+    if (coeffs.m_unitCoefficients) {
+      DataOps::setValue(helmAco, 1.0);
+      DataOps::setValue(helmBco, 1.0);
+      DataOps::setValue(helmBcoIrreg, 1.0);
+    }
+    else {
+      const DisjointBoxLayout& dbl = grids[lvl];
+
+      // This loop fills aco with kappa and bco/bco_irreg with 1./(3*kappa)
+      for (DataIterator dit(dbl); dit.ok(); ++dit) {
+        this->setHelmholtzCoefficientsBox(helmAco[dit()], helmBco[dit()], helmBcoIrreg[dit()], lvl, dit());
+      }
+    }
+  }
+
+  coeffs.m_grids = grids;
+}
+
+bool
+EddingtonSP1::useUnitCoefficients() const
+{
+  CH_TIME("EddingtonSP1::useUnitCoefficients");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::useUnitCoefficients" << endl;
+  }
+
+  // For transient solves the A-coefficient also multiplies the time derivative, so we can't move kappa into alpha.
+  return m_stationary && m_rtSpecies->isAbsorptionCoefficientConstant();
+}
+
+bool
+EddingtonSP1::canShareSolver() const
+{
+  CH_TIME("EddingtonSP1::canShareSolver");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::canShareSolver" << endl;
+  }
 
-    LevelData<EBCellFAB>&       helmAco      = *m_helmAco[lvl];
-    LevelData<EBFluxFAB>&       helmBco      = *m_helmBco[lvl];
-    LevelData<BaseIVFAB<Real>>& helmBcoIrreg = *m_helmBcoIrreg[lvl];
+  // Larsen boundary conditions use the absorption coefficient in the Robin coefficients, and user-set boundary condition functions
+  // might differ between species. In these cases each instance needs its own operators.
+  bool canShare = this->useUnitCoefficients() && !m_hasCustomBcFunctions && (m_ebbc.first != EBBCType::Larsen);
+
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    for (SideIterator sit; sit.ok(); ++sit) {
+      const EddingtonSP1DomainBc::DomainSide domainSide = std::make_pair(dir, sit());
 
-    // Fill data in each grid patch.
-    for (DataIterator dit(dbl); dit.ok(); ++dit) {
-      this->setHelmholtzCoefficientsBox(helmAco[dit()], helmBco[dit()], helmBcoIrreg[dit()], lvl, dit());
+      if (m_domainBc.getBc(domainSide).first == EddingtonSP1DomainBc::BcType::Larsen) {
+        canShare = false;
+      }
     }
   }
+
+  return canShare;
+}
+
+std::string
+EddingtonSP1::getSharingKey() const
+{
+  CH_TIME("EddingtonSP1::getSharingKey");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::getSharingKey" << endl;
+  }
+
+  // All instances parse the same options (through m_className), so only the realm and phase can differ.
+  return m_className + "." + m_realm + "." + std::to_string(static_cast<int>(m_phase));
+}
+
+Real
+EddingtonSP1::getHelmholtzAlpha() const
+{
+  CH_TIME("EddingtonSP1::getHelmholtzAlpha");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::getHelmholtzAlpha" << endl;
+  }
+
+  Real alpha = m_alpha;
+
+  if (m_helmholtzCoefficients->m_unitCoefficients) {
+    alpha *= m_rtSpecies->getAbsorptionCoefficient(m_amr->getProbLo());
+  }
+
+  return alpha;
+}
+
+Real
+EddingtonSP1::getHelmholtzBeta() const
+{
+  CH_TIME("EddingtonSP1::getHelmholtzBeta");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::getHelmholtzBeta" << endl;
+  }
+
+  Real beta = m_beta;
+
+  if (m_helmholtzCoefficients->m_unitCoefficients) {
+    beta /= (3.0 * m_rtSpecies->getAbsorptionCoefficient(m_amr->getProbLo()));
+  }
+
+  return beta;
+}
+
+void
+EddingtonSP1::resetAlphaAndBeta()
+{
+  CH_TIME("EddingtonSP1::resetAlphaAndBeta");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::resetAlphaAndBeta" << endl;
+  }
+
+  CH_assert(m_sharedSolver);
+
+  const Real alpha = this->getHelmholtzAlpha();
+  const Real beta  = this->getHelmholtzBeta();
+
+  if (alpha != m_sharedSolver->m_alpha || beta != m_sharedSolver->m_beta) {
+    Vector<MGLevelOp<LevelData<EBCellFAB>>*> multigridOperators = m_multigridSolver->getAllOperators();
+
+    for (int i = 0; i < multigridOperators.size(); i++) {
+      TGAHelmOp<LevelData<EBCellFAB>>* helmholtzOperator = (TGAHelmOp<LevelData<EBCellFAB>>*)multigridOperators[i];
+
+      helmholtzOperator->setAlphaAndBeta(alpha, beta);
+    }
+
+    m_sharedSolver->m_alpha = alpha;
+    m_sharedSolver->m_beta  = beta;
+  }
 }
 
 void
@@ -875,8 +1123,8 @@ EddingtonSP1::setupHelmholtzFactory()
 
   // Set up the operator
   m_helmholtzOpFactory = RefCountedPtr<EBHelmholtzOpFactory>(new EBHelmholtzOpFactory(m_dataLocation,
-                                                                                      m_alpha,
-                                                                                      m_beta,
+                                                                                      this->getHelmholtzAlpha(),
+                                                                                      this->getHelmholtzBeta(),
                                                                                       m_amr->getProbLo(),
                                                                                       levelGrids,
                                                                                       interpolator,
@@ -884,9 +1132,9 @@ EddingtonSP1::setupHelmholtzFactory()
                                                                                       coarAve,
                                                                                       m_amr->getRefinementRatios(),
                                                                                       m_amr->getDx(),
-                                                                                      m_helmAco.getData(),
-                                                                                      m_helmBco.getData(),
-                                                                                      m_helmBcoIrreg.getData(),
+                                                                                      m_helmholtzCoefficients->m_helmAco.getData(),
+                                                                                      m_helmholtzCoefficients->m_helmBco.getData(),
+                                                                                      m_helmholtzCoefficients->m_helmBcoIrreg.getData(),
                                                                                       domainBcFactory,
                                                                                       ebbcFactory,
                                                                                       ghostPhi,
@@ -1107,7 +1355,7 @@ EddingtonSP1::computeFlux(EBAMRCellData& a_flux, const EBAMRCellData& a_phi)
   // Equations say flux = -c/(3*kappa)*grad(Psi).
   //
   // We happen that our discretization uses Aco = kappa, so we just divide by it rather than computing
-  // it on the mesh again.
+  // it on the mesh again. If the absorption coefficient is constant then Aco = 1 and we scale by 1/kappa instead.
 
   EBAMRCellData scratch;
   m_amr->allocate(scratch, m_realm, m_phase, m_nComp);
@@ -1116,8 +1364,16 @@ EddingtonSP1::computeFlux(EBAMRCellData& a_flux, const EBAMRCellData& a_phi)
   m_amr->interpGhostMG(scratch, m_realm, m_phase);
   m_amr->computeGradient(a_flux, a_phi, m_realm, m_phase); // flux = grad(phi)
 
+  const bool unitCoefficients = m_helmholtzCoefficients->m_unitCoefficients;
+  const Real kappa            = unitCoefficients ? m_rtSpecies->getAbsorptionCoefficient(m_amr->getProbLo()) : 1.0;
+
   for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
-    DataOps::divideByScalar(*a_flux[lvl], *m_helmAco[lvl]);   // flux = grad(phi)/(c*kappa)
+    if (unitCoefficients) {
+      DataOps::scale(*a_flux[lvl], 1.0 / kappa); // flux = grad(phi)/kappa
+    }
+    else {
+      DataOps::divideByScalar(*a_flux[lvl], *m_helmholtzCoefficients->m_helmAco[lvl]); // flux = grad(phi)/kappa
+    }
     DataOps::scale(*a_flux[lvl], -Units::c * Units::c / 3.0); // flux = -c*grad(phi)/3.
   }
 
@@ -29,6 +29,8 @@
 #include <CD_Units.H>
 #include <CD_ParticleOps.H>
 #include <CD_Random.H>
+#include <CD_MemoryReport.H>
+#include <CD_DischargeIO.H>
 #include <CD_NamespaceHeader.H>
 
 #define MC_PHOTO_DEBUG 0
@@ -40,7 +42,8 @@ McPhoto::McPhoto()
   m_name      = "McPhoto";
   m_className = "McPhoto";
 
-  m_stationary = false;
+  m_stationary    = false;
+  m_checkpointing = WhichCheckpoint::Particles;
 }
 
 McPhoto::~McPhoto() {}
@@ -107,6 +110,7 @@ McPhoto::parseOptions()
   this->parsePlotVariables();
   this->parseInstantaneous();
   this->parseDivergenceComputation();
+  this->parseCheckpointing();
 }
 
 void
@@ -126,6 +130,7 @@ McPhoto::parseRuntimeOptions()
   this->parsePlotVariables();
   this->parseInstantaneous();
   this->parseDivergenceComputation();
+  this->parseCheckpointing();
 }
 
 void
@@ -141,6 +146,30 @@ McPhoto::parseDivergenceComputation()
   pp.get("blend_conservation", m_blendConservation);
 }
 
+void
+McPhoto::parseCheckpointing()
+{
+  CH_TIME("McPhoto::parseCheckpointing");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parseCheckpointing" << endl;
+  }
+
+  ParmParse pp(m_className.c_str());
+
+  std::string str;
+  pp.get("checkpointing", str);
+
+  if (str == "particles") {
+    m_checkpointing = WhichCheckpoint::Particles;
+  }
+  else if (str == "blocks") {
+    m_checkpointing = WhichCheckpoint::Blocks;
+  }
+  else {
+    MayDay::Error("McPhoto::parseCheckpointing -- unknown checkpointing method requested");
+  }
+}
+
 void
 McPhoto::parseInstantaneous()
 {
@@ -438,6 +467,8 @@ McPhoto::allocateInternals()
     pout() << m_name + "::allocateInternals" << endl;
   }
 
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
   // Allocate mesh data
   m_amr->allocate(m_phi, m_realm, m_phase, m_nComp);
   m_amr->allocate(m_source, m_realm, m_phase, m_nComp);
@@ -669,9 +700,51 @@ McPhoto::writeCheckpointLevel(HDF5Handle& a_handle, const int a_level) const
   // Write state vector
   write(a_handle, *m_phi[a_level], m_name);
 
-  // Write particles. Must be implemented.
-  std::string str = m_name + "_particles";
-  writeParticlesToHDF(a_handle, m_photons[a_level], str);
+  // Write particles.
+  switch (m_checkpointing) {
+  case WhichCheckpoint::Particles: {
+    std::string str = m_name + "_particles";
+    writeParticlesToHDF(a_handle, m_photons[a_level], str);
+
+    break;
+  }
+  case WhichCheckpoint::Blocks: {
+    constexpr int numFields = 2 * SpaceDim + 2;
+
+    const std::string        str = m_name + "_particlesB";
+    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[a_level];
+
+    // Flatten the photons into position, velocity, kappa, and mass.
+    LayoutData<std::vector<Real>> photonFields(dbl);
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const List<Photon>& photons = m_photons[a_level][dit()].listItems();
+
+      std::vector<Real>& fields = photonFields[dit()];
+
+      fields.reserve(numFields * photons.length());
+
+      for (ListIterator<Photon> lit(photons); lit.ok(); ++lit) {
+        const Photon& p = lit();
+
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          fields.emplace_back(p.position()[dir]);
+        }
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          fields.emplace_back(p.velocity()[dir]);
+        }
+        fields.emplace_back(p.kappa());
+        fields.emplace_back(p.mass());
+      }
+    }
+
+    DischargeIO::writeParticleBlocks(a_handle, str, dbl, photonFields, numFields);
+
+    break;
+  }
+  default:
+    MayDay::Error("McPhoto::writeCheckpointLevel -- logic bust");
+  }
 }
 #endif
 
@@ -687,9 +760,52 @@ McPhoto::readCheckpointLevel(HDF5Handle& a_handle, const int a_level)
   // Read state vector
   read<EBCellFAB>(a_handle, *m_phi[a_level], m_name, m_amr->getGrids(m_realm)[a_level], Interval(0, 0), false);
 
-  // Read particles. Should be implemented
-  std::string str = m_name + "_particles";
-  readParticlesFromHDF(a_handle, m_photons[a_level], str);
+  // Read particles.
+  switch (m_checkpointing) {
+  case WhichCheckpoint::Particles: {
+    std::string str = m_name + "_particles";
+    readParticlesFromHDF(a_handle, m_photons[a_level], str);
+
+    break;
+  }
+  case WhichCheckpoint::Blocks: {
+    constexpr int numFields = 2 * SpaceDim + 2;
+
+    const std::string        str = m_name + "_particlesB";
+    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[a_level];
+
+    // Each rank only reads the photons inside its own boxes.
+    LayoutData<std::vector<Real>> photonFields(dbl);
+
+    DischargeIO::readParticleBlocks(a_handle,
+                                    str,
+                                    dbl,
+                                    m_amr->getProbLo(),
+                                    m_amr->getDx()[a_level],
+                                    photonFields,
+                                    numFields);
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      List<Photon>&            photons = m_photons[a_level][dit()].listItems();
+      const std::vector<Real>& fields  = photonFields[dit()];
+
+      for (size_t i = 0; i < fields.size(); i += numFields) {
+        RealVect position;
+        RealVect velocity;
+        for (int dir = 0; dir < SpaceDim; dir++) {
+          position[dir] = fields[i + dir];
+          velocity[dir] = fields[i + SpaceDim + dir];
+        }
+
+        photons.append(Photon(position, velocity, fields[i + 2 * SpaceDim], fields[i + 2 * SpaceDim + 1]));
+      }
+    }
+
+    break;
+  }
+  default:
+    MayDay::Error("McPhoto::readCheckpointLevel -- logic bust");
+  }
 }
 #endif
 
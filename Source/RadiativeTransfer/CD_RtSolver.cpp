@@ -16,6 +16,7 @@
 // Our includes
 #include <CD_RtSolver.H>
 #include <CD_DataOps.H>
+#include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
 constexpr int RtSolver::m_comp;
@@ -30,7 +31,12 @@ RtSolver::RtSolver()
   m_className = "RtSolver";
 }
 
-RtSolver::~RtSolver() { CH_TIME("RtSolver::~RtSolver"); }
+RtSolver::~RtSolver()
+{
+  CH_TIME("RtSolver::~RtSolver");
+
+  MemoryReport::releaseMemory(this);
+}
 
 std::string
 RtSolver::getName()
@@ -33,4 +33,10 @@ RtSpecies::getScatteringCoefficient(const RealVect a_pos) const
   return 0.0;
 }
 
+bool
+RtSpecies::isAbsorptionCoefficientConstant() const noexcept
+{
+  return false;
+}
+
 #include <CD_NamespaceFooter.H>
@@ -0,0 +1,1053 @@
+/* chombo-discharge
+ * Copyright © 2021 SINTEF Energy Research.
+ * Please refer to Copyright.txt and LICENSE in the chombo-discharge root directory.
+ */
+
+/*!
+  @file   CD_TreePhoto.cpp
+  @brief  Implementation of CD_TreePhoto.H
+  @author Robert Marskar
+*/
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <limits>
+
+// Chombo includes
+#include <ParmParse.H>
+#include <EBAMRIO.H>
+
+// Our includes
+#include <CD_TreePhoto.H>
+#include <CD_DataOps.H>
+#include <CD_Units.H>
+#include <CD_BoxLoops.H>
+#include <CD_ParallelOps.H>
+#include <CD_DischargeIO.H>
+#include <CD_MemoryReport.H>
+#include <CD_NamespaceHeader.H>
+
+constexpr int  TreePhoto::m_numBickleyPoints;
+constexpr Real TreePhoto::m_maxBickleyArgument;
+
+TreePhoto::TreePhoto() : RtSolver()
+{
+  CH_TIME("TreePhoto::TreePhoto");
+
+  // Default settings
+  m_name      = "TreePhoto";
+  m_className = "TreePhoto";
+
+  m_verbosity    = -1;
+  m_stationary   = true;
+  m_dataLocation = Location::Cell::Center;
+
+  m_domainBc.resize(2 * SpaceDim, BcType::Outflow);
+
+  if (SpaceDim == 2) {
+    this->tabulateBickley();
+  }
+}
+
+TreePhoto::~TreePhoto() { CH_TIME("TreePhoto::~TreePhoto"); }
+
+void
+TreePhoto::parseOptions()
+{
+  CH_TIME("TreePhoto::parseOptions");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parseOptions" << endl;
+  }
+
+  this->parseTreeSettings();  // Parses accuracy settings
+  this->parsePlotVariables(); // Parses plot variables
+  this->parseDomainBC();      // Parses domain boundary conditions
+}
+
+void
+TreePhoto::parseRuntimeOptions()
+{
+  CH_TIME("TreePhoto::parseRuntimeOptions");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parseRuntimeOptions" << endl;
+  }
+
+  this->parseTreeSettings();
+  this->parsePlotVariables();
+}
+
+void
+TreePhoto::parseTreeSettings()
+{
+  CH_TIME("TreePhoto::parseTreeSettings");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parseTreeSettings" << endl;
+  }
+
+  ParmParse pp(m_className.c_str());
+
+  pp.get("theta", m_theta);
+  pp.get("max_optical_depth", m_maxOpticalDepth);
+  pp.get("source_threshold", m_sourceThreshold);
+  pp.get("leaf_size", m_leafSize);
+
+  if (m_theta < 0.0) {
+    MayDay::Error("TreePhoto::parseTreeSettings -- 'theta' must be >= 0");
+  }
+  if (m_leafSize < 1) {
+    MayDay::Error("TreePhoto::parseTreeSettings -- 'leaf_size' must be > 0");
+  }
+}
+
+void
+TreePhoto::parsePlotVariables()
+{
+  CH_TIME("TreePhoto::parsePlotVariables");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parsePlotVariables" << endl;
+  }
+
+  m_plotPhi    = false;
+  m_plotSource = false;
+
+  ParmParse           pp(m_className.c_str());
+  const int           num = pp.countval("plt_vars");
+  Vector<std::string> str(num);
+  pp.getarr("plt_vars", str, 0, num);
+
+  for (int i = 0; i < num; i++) {
+    if (str[i] == "phi")
+      m_plotPhi = true;
+    else if (str[i] == "src")
+      m_plotSource = true;
+  }
+}
+
+void
+TreePhoto::parseDomainBC()
+{
+  CH_TIME("TreePhoto::parseDomainBC");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::parseDomainBC" << endl;
+  }
+
+  ParmParse pp(m_className.c_str());
+
+  const std::string dirString[3] = {"x", "y", "z"};
+
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    for (SideIterator sit; sit.ok(); ++sit) {
+      const std::string sideString = (sit() == Side::Lo) ? "low" : "high";
+      const std::string bcString   = "bc_" + dirString[dir] + "_" + sideString;
+
+      std::string str;
+      pp.get(bcString.c_str(), str);
+
+      BcType bcType;
+      if (str == "outflow") {
+        bcType = BcType::Outflow;
+      }
+      else if (str == "symmetry") {
+        bcType = BcType::Symmetry;
+      }
+      else {
+        const std::string err = "TreePhoto::parseDomainBC -- unknown boundary condition '" + str + "' for " + bcString;
+
+        MayDay::Error(err.c_str());
+      }
+
+      m_domainBc[2 * dir + ((sit() == Side::Lo) ? 0 : 1)] = bcType;
+    }
+  }
+}
+
+void
+TreePhoto::setStationary(const bool a_stationary)
+{
+  CH_TIME("TreePhoto::setStationary");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::setStationary" << endl;
+  }
+
+  m_stationary = true;
+}
+
+void
+TreePhoto::tabulateBickley()
+{
+  CH_TIME("TreePhoto::tabulateBickley");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::tabulateBickley" << endl;
+  }
+
+  // TLDR: The Bickley-Naylor functions are Ki_n(x) = int_0^(pi/2) exp(-x/cos(t)) * cos(t)^(n-1) dt. The integrand is smooth
+  //       and vanishes at t = pi/2 when x > 0, so a midpoint rule is very accurate.
+  constexpr int numQuad = 512;
+
+  const Real dt = 0.5 * Units::pi / numQuad;
+  const Real dx = m_maxBickleyArgument / (m_numBickleyPoints - 1);
+
+  m_bickleyOne.resize(m_numBickleyPoints);
+  m_bickleyTwo.resize(m_numBickleyPoints);
+
+  for (int i = 0; i < m_numBickleyPoints; i++) {
+    const Real x = i * dx;
+
+    Real kiOne = 0.0;
+    Real kiTwo = 0.0;
+
+    for (int j = 0; j < numQuad; j++) {
+      const Real cosT = std::cos((j + 0.5) * dt);
+      const Real f    = std::exp(-x / cosT);
+
+      kiOne += f;
+      kiTwo += f * cosT;
+    }
+
+    m_bickleyOne[i] = kiOne * dt;
+    m_bickleyTwo[i] = kiTwo * dt;
+  }
+}
+
+Real
+TreePhoto::interpolateBickley(const std::vector<Real>& a_table, const Real a_x) const noexcept
+{
+  Real ret = 0.0;
+
+  const Real t = a_x * (m_numBickleyPoints - 1) / m_maxBickleyArgument;
+  const int  i = int(t);
+
+  if (i < m_numBickleyPoints - 1) {
+    const Real w = t - i;
+
+    ret = (1.0 - w) * a_table[i] + w * a_table[i + 1];
+  }
+
+  return ret;
+}
+
+Real
+TreePhoto::kernel(const Real a_kappa, const Real a_r) const noexcept
+{
+#if CH_SPACEDIM == 2
+  return this->interpolateBickley(m_bickleyOne, a_kappa * a_r) / (2.0 * Units::pi * a_r);
+#else
+  return std::exp(-a_kappa * a_r) / (4.0 * Units::pi * a_r * a_r);
+#endif
+}
+
+Real
+TreePhoto::selfIntegral(const Real a_kappa, const Real a_volume) const noexcept
+{
+  // TLDR: Integrate the kernel over a sphere (disk in 2D) with radius a. In 3D this is (1 - exp(-kappa*a))/kappa and in
+  //       2D it is (1 - Ki2(kappa*a))/kappa since d(Ki2)/dx = -Ki1. For optically thin cells both reduce to a.
+#if CH_SPACEDIM == 2
+  const Real a = std::sqrt(a_volume / Units::pi);
+#else
+  const Real a = std::cbrt(3.0 * a_volume / (4.0 * Units::pi));
+#endif
+
+  Real ret = a;
+
+  if (a_kappa * a > 1.E-6) {
+#if CH_SPACEDIM == 2
+    ret = (1.0 - this->interpolateBickley(m_bickleyTwo, a_kappa * a)) / a_kappa;
+#else
+    ret = (1.0 - std::exp(-a_kappa * a)) / a_kappa;
+#endif
+  }
+
+  return ret;
+}
+
+void
+TreePhoto::allocateInternals()
+{
+  CH_TIME("TreePhoto::allocateInternals");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::allocateInternals" << endl;
+  }
+
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
+  m_amr->allocate(m_phi, m_realm, m_phase, m_nComp);
+  m_amr->allocate(m_source, m_realm, m_phase, m_nComp);
+
+  DataOps::setValue(m_phi, 0.0);
+  DataOps::setValue(m_source, 0.0);
+}
+
+void
+TreePhoto::deallocateInternals()
+{
+  CH_TIME("TreePhoto::deallocateInternals");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::deallocateInternals" << endl;
+  }
+
+  MemoryReport::MemoryScope memoryScope(MemoryReport::Category::Solvers, this);
+
+  m_amr->deallocate(m_phi);
+  m_amr->deallocate(m_source);
+
+  m_sources.clear();
+  m_nodes.clear();
+}
+
+void
+TreePhoto::preRegrid(const int a_base, const int a_oldFinestLevel)
+{
+  CH_TIME("TreePhoto::preRegrid");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::preRegrid" << endl;
+  }
+
+  m_amr->allocate(m_cachePhi, m_realm, m_phase, m_nComp);
+  m_amr->allocate(m_cacheSrc, m_realm, m_phase, m_nComp);
+
+  for (int lvl = 0; lvl <= a_oldFinestLevel; lvl++) {
+    m_phi[lvl]->localCopyTo(*m_cachePhi[lvl]);
+    m_source[lvl]->localCopyTo(*m_cacheSrc[lvl]);
+  }
+}
+
+void
+TreePhoto::regrid(const int a_lmin, const int a_oldFinestLevel, const int a_newFinestLevel)
+{
+  CH_TIME("TreePhoto::regrid");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::regrid" << endl;
+  }
+
+  this->allocateInternals();
+
+  m_amr->interpToNewGrids(m_phi, m_cachePhi, m_phase, a_lmin, a_oldFinestLevel, a_newFinestLevel, true);
+  m_amr->interpToNewGrids(m_source, m_cacheSrc, m_phase, a_lmin, a_oldFinestLevel, a_newFinestLevel, true);
+
+  m_amr->averageDown(m_phi, m_realm, m_phase);
+  m_amr->interpGhost(m_phi, m_realm, m_phase);
+
+  m_amr->deallocate(m_cachePhi);
+  m_amr->deallocate(m_cacheSrc);
+}
+
+void
+TreePhoto::registerOperators()
+{
+  CH_TIME("TreePhoto::registerOperators");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::registerOperators" << endl;
+  }
+
+  if (m_amr.isNull()) {
+    MayDay::Error("TreePhoto::registerOperators - need to set AmrMesh!");
+  }
+  else {
+    m_amr->registerOperator(s_eb_coar_ave, m_realm, m_phase);
+    m_amr->registerOperator(s_eb_fill_patch, m_realm, m_phase);
+    m_amr->registerOperator(s_eb_irreg_interp, m_realm, m_phase);
+    m_amr->registerOperator(s_eb_fine_interp, m_realm, m_phase);
+  }
+}
+
+bool
+TreePhoto::advance(const Real a_dt, EBAMRCellData& a_phi, const EBAMRCellData& a_source, const bool a_zeroPhi)
+{
+  CH_TIME("TreePhoto::advance(ebamrcell, ebamrcell)");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::advance(ebamrcell, ebamrcell)" << endl;
+  }
+
+  // TLDR: We compute Psi(x) = (1/c) * int eta(y) K(|x-y|) dy in every valid cell. The local sources and the sources
+  //       that this rank needs from other ranks are put in a kd-tree, and the integral is evaluated with the tree. The contribution from the cell itself is
+  //       integrated analytically, so we exclude sources that are (essentially) on top of the evaluation point. Cells that
+  //       are covered by a finer level are filled by averaging down.
+  this->gatherSources(a_source);
+  this->buildTree();
+
+  constexpr int comp = 0;
+
+  const RealVect probLo = m_amr->getProbLo();
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    const DisjointBoxLayout& dbl     = m_amr->getGrids(m_realm)[lvl];
+    const EBISLayout&        ebisl   = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
+    const Real               dx      = m_amr->getDx()[lvl];
+    const Real               minDist = 1.E-3 * dx;
+    const Real               volume  = std::pow(dx, SpaceDim);
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      EBCellFAB&           phi        = (*a_phi[lvl])[dit()];
+      const EBCellFAB&     source     = (*a_source[lvl])[dit()];
+      const EBISBox&       ebisbox    = ebisl[dit()];
+      const BaseFab<bool>& validCells = (*m_amr->getValidCells(m_realm)[lvl])[dit()];
+      const Box            cellBox    = dbl[dit()];
+
+      BaseFab<Real>&       phiReg    = phi.getSingleValuedFAB();
+      const BaseFab<Real>& sourceReg = source.getSingleValuedFAB();
+
+      auto evaluateCell = [&](const RealVect& pos, const Real eta, const Real vol) -> Real {
+        const Real kappa = m_rtSpecies->getAbsorptionCoefficient(pos);
+
+        Real ret = this->evaluate(pos, kappa, minDist);
+
+        for (const auto& image : this->getImages(pos)) {
+          ret += this->evaluate(image, kappa, -1.0);
+        }
+
+        ret += eta * this->selfIntegral(kappa, vol);
+
+        return ret / Units::c;
+      };
+
+      // Regular cells
+      auto regularKernel = [&](const IntVect& iv) -> void {
+        phiReg(iv, comp) = 0.0;
+
+        if (validCells(iv, comp) && ebisbox.isRegular(iv)) {
+          const RealVect pos = probLo + (0.5 * RealVect::Unit + RealVect(iv)) * dx;
+
+          phiReg(iv, comp) = evaluateCell(pos, sourceReg(iv, comp), volume);
+        }
+      };
+
+      // Cut-cells
+      auto irregularKernel = [&](const VolIndex& vof) -> void {
+        phi(vof, comp) = 0.0;
+
+        if (validCells(vof.gridIndex(), comp)) {
+          const RealVect pos = probLo + Location::position(m_dataLocation, vof, ebisbox, dx);
+
+          phi(vof, comp) = evaluateCell(pos, source(vof, comp), ebisbox.volFrac(vof) * volume);
+        }
+      };
+
+      VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
+
+      BoxLoops::loop(cellBox, regularKernel);
+      BoxLoops::loop(vofit, irregularKernel);
+    }
+  }
+
+  DataOps::setCoveredValue(a_phi, 0, 0.0);
+
+  m_amr->averageDown(a_phi, m_realm, m_phase);
+  m_amr->interpGhost(a_phi, m_realm, m_phase);
+
+  return true;
+}
+
+void
+TreePhoto::gatherSources(const EBAMRCellData& a_source)
+{
+  CH_TIME("TreePhoto::gatherSources");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::gatherSources" << endl;
+  }
+
+  // TLDR: Each rank collects the sources (emission times cell volume) in its valid cells. Sources below the threshold are
+  //       discarded, and the sources on other ranks that are needed for evaluating the integral on this rank are fetched
+  //       with exchangeSources().
+  constexpr int comp = 0;
+
+  const RealVect probLo = m_amr->getProbLo();
+
+  m_sources.resize(0);
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    const DisjointBoxLayout& dbl    = m_amr->getGrids(m_realm)[lvl];
+    const EBISLayout&        ebisl  = m_amr->getEBISLayout(m_realm, m_phase)[lvl];
+    const Real               dx     = m_amr->getDx()[lvl];
+    const Real               volume = std::pow(dx, SpaceDim);
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const EBCellFAB&     source     = (*a_source[lvl])[dit()];
+      const BaseFab<Real>& sourceReg  = source.getSingleValuedFAB();
+      const EBISBox&       ebisbox    = ebisl[dit()];
+      const BaseFab<bool>& validCells = (*m_amr->getValidCells(m_realm)[lvl])[dit()];
+      const Box            cellBox    = dbl[dit()];
+
+      auto addSource = [&](const RealVect& pos, const Real weight) -> void {
+        if (weight != 0.0) {
+          Source s;
+
+          s.m_position = pos;
+          s.m_weight   = weight;
+
+          m_sources.emplace_back(s);
+        }
+      };
+
+      auto regularKernel = [&](const IntVect& iv) -> void {
+        if (validCells(iv, comp) && ebisbox.isRegular(iv)) {
+          addSource(probLo + (0.5 * RealVect::Unit + RealVect(iv)) * dx, sourceReg(iv, comp) * volume);
+        }
+      };
+
+      auto irregularKernel = [&](const VolIndex& vof) -> void {
+        if (validCells(vof.gridIndex(), comp)) {
+          addSource(probLo + Location::position(m_dataLocation, vof, ebisbox, dx),
+                    source(vof, comp) * ebisbox.volFrac(vof) * volume);
+        }
+      };
+
+      VoFIterator& vofit = (*m_amr->getVofIterator(m_realm, m_phase)[lvl])[dit()];
+
+      BoxLoops::loop(cellBox, regularKernel);
+      BoxLoops::loop(vofit, irregularKernel);
+    }
+  }
+
+  // Remove weak sources.
+  if (m_sourceThreshold > 0.0) {
+    Real maxWeight = 0.0;
+    for (const auto& s : m_sources) {
+      maxWeight = std::max(maxWeight, std::abs(s.m_weight));
+    }
+
+    const Real threshold = m_sourceThreshold * ParallelOps::max(maxWeight);
+
+    m_sources.erase(std::remove_if(m_sources.begin(),
+                                   m_sources.end(),
+                                   [threshold](const Source& s) -> bool { return std::abs(s.m_weight) < threshold; }),
+                    m_sources.end());
+  }
+
+  this->exchangeSources();
+}
+
+void
+TreePhoto::exchangeSources()
+{
+  CH_TIME("TreePhoto::exchangeSources");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::exchangeSources" << endl;
+  }
+
+  // TLDR: Rather than sending every source to every rank, each rank sends a locally essential tree to the other ranks. We build
+  //       a tree over the local sources and, for every other rank, walk it with the same opening criterion that evaluate() uses,
+  //       but with the distance to the closest cell on that rank (or its mirror images). Nodes that the receiver would accept
+  //       for all of its cells are sent as a single source at the node center, and the leaves that have to be opened are sent
+  //       as raw sources. If the absorption coefficient is constant we can also skip the nodes that are optically far away from
+  //       all of the receiving cells.
+#ifdef CH_MPI
+  constexpr int stride = SpaceDim + 1;
+
+  const int numRanks = numProc();
+  const int myRank   = procID();
+
+  const RealVect probLo = m_amr->getProbLo();
+  const RealVect probHi = m_amr->getProbHi();
+
+  // Physical regions where each rank evaluates the integral, including the mirror images through the symmetry sides.
+  std::vector<std::vector<std::pair<RealVect, RealVect>>> targets(numRanks);
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[lvl];
+    const Real               dx  = m_amr->getDx()[lvl];
+
+    for (LayoutIterator lit = dbl.layoutIterator(); lit.ok(); ++lit) {
+      const Box      box = dbl[lit()];
+      const RealVect lo  = probLo + RealVect(box.smallEnd()) * dx;
+      const RealVect hi  = probLo + RealVect(box.bigEnd() + IntVect::Unit) * dx;
+
+      std::vector<std::pair<RealVect, RealVect>>& rankTargets = targets[dbl.procID(lit())];
+
+      rankTargets.emplace_back(lo, hi);
+
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        if (m_domainBc[2 * dir] == BcType::Symmetry) {
+          RealVect imageLo = lo;
+          RealVect imageHi = hi;
+
+          imageLo[dir] = 2.0 * probLo[dir] - hi[dir];
+          imageHi[dir] = 2.0 * probLo[dir] - lo[dir];
+
+          rankTargets.emplace_back(imageLo, imageHi);
+        }
+        if (m_domainBc[2 * dir + 1] == BcType::Symmetry) {
+          RealVect imageLo = lo;
+          RealVect imageHi = hi;
+
+          imageLo[dir] = 2.0 * probHi[dir] - hi[dir];
+          imageHi[dir] = 2.0 * probHi[dir] - lo[dir];
+
+          rankTargets.emplace_back(imageLo, imageHi);
+        }
+      }
+    }
+  }
+
+  // Squared distance between two boxes.
+  auto boxDistance2 = [](const RealVect& aLo, const RealVect& aHi, const RealVect& bLo, const RealVect& bHi) -> Real {
+    Real d2 = 0.0;
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      const Real d = std::max(std::max(aLo[dir] - bHi[dir], bLo[dir] - aHi[dir]), 0.0);
+
+      d2 += d * d;
+    }
+
+    return d2;
+  };
+
+  const bool constantKappa = m_rtSpecies->isAbsorptionCoefficientConstant();
+  const Real kappa         = constantKappa ? m_rtSpecies->getAbsorptionCoefficient(probLo) : 0.0;
+
+  this->buildTree();
+
+  std::vector<std::vector<Real>> sendBuffers(numRanks);
+
+  for (int rank = 0; rank < numRanks; rank++) {
+    if (rank == myRank || targets[rank].empty() || m_nodes.empty()) {
+      continue;
+    }
+
+    std::vector<Real>&                                buffer      = sendBuffers[rank];
+    const std::vector<std::pair<RealVect, RealVect>>& rankTargets = targets[rank];
+
+    auto pack = [&buffer](const RealVect& a_position, const Real a_weight) -> void {
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        buffer.emplace_back(a_position[dir]);
+      }
+      buffer.emplace_back(a_weight);
+    };
+
+    std::vector<int> stack(1, 0);
+
+    while (!(stack.empty())) {
+      const Node& node = m_nodes[stack.back()];
+
+      stack.pop_back();
+
+      Real minDist2   = std::numeric_limits<Real>::max();
+      Real minCenter2 = std::numeric_limits<Real>::max();
+
+      for (const auto& target : rankTargets) {
+        minDist2   = std::min(minDist2, boxDistance2(node.m_lo, node.m_hi, target.first, target.second));
+        minCenter2 = std::min(minCenter2, boxDistance2(node.m_center, node.m_center, target.first, target.second));
+      }
+
+      if (constantKappa && kappa * std::sqrt(minDist2) > m_maxOpticalDepth) {
+        continue;
+      }
+
+      if (minDist2 > 0.0 && node.m_size < m_theta * std::sqrt(minCenter2)) {
+        pack(node.m_center, node.m_weight);
+      }
+      else if (node.m_children[0] < 0) {
+        for (int i = node.m_begin; i < node.m_end; i++) {
+          pack(m_sources[i].m_position, m_sources[i].m_weight);
+        }
+      }
+      else {
+        stack.emplace_back(node.m_children[0]);
+        stack.emplace_back(node.m_children[1]);
+      }
+    }
+  }
+
+  // Exchange the message sizes. These are 64-bit, but MPI counts are int so each message must fit in one.
+  std::vector<long long> sendCounts(numRanks);
+  std::vector<long long> recvCounts(numRanks);
+
+  for (int rank = 0; rank < numRanks; rank++) {
+    sendCounts[rank] = sendBuffers[rank].size();
+  }
+
+  MPI_Alltoall(&sendCounts[0], 1, MPI_LONG_LONG, &recvCounts[0], 1, MPI_LONG_LONG, Chombo_MPI::comm);
+
+  long long numRecv = 0;
+  for (int rank = 0; rank < numRanks; rank++) {
+    if (sendCounts[rank] > INT_MAX || recvCounts[rank] > INT_MAX) {
+      MayDay::Error("TreePhoto::exchangeSources -- message too large, try increasing TreePhoto.theta or TreePhoto.source_threshold");
+    }
+
+    numRecv += recvCounts[rank];
+  }
+
+  const size_t numLocal = m_sources.size();
+
+  std::vector<Real> recvBuffer(numRecv);
+
+  std::vector<MPI_Request> requests;
+
+  long long offset = 0;
+  for (int rank = 0; rank < numRanks; rank++) {
+    if (recvCounts[rank] > 0) {
+      requests.emplace_back();
+      MPI_Irecv(&recvBuffer[offset],
+                static_cast<int>(recvCounts[rank]),
+                MPI_CH_REAL,
+                rank,
+                0,
+                Chombo_MPI::comm,
+                &requests.back());
+
+      offset += recvCounts[rank];
+    }
+  }
+
+  for (int rank = 0; rank < numRanks; rank++) {
+    if (sendCounts[rank] > 0) {
+      requests.emplace_back();
+      MPI_Isend(sendBuffers[rank].data(),
+                static_cast<int>(sendCounts[rank]),
+                MPI_CH_REAL,
+                rank,
+                0,
+                Chombo_MPI::comm,
+                &requests.back());
+    }
+  }
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  // Append the received sources to the local ones. The tree is rebuilt over all of them by the caller.
+  m_sources.resize(numLocal + numRecv / stride);
+
+  for (size_t i = 0; i < static_cast<size_t>(numRecv / stride); i++) {
+    Source& s = m_sources[numLocal + i];
+
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      s.m_position[dir] = recvBuffer[i * stride + dir];
+    }
+    s.m_weight = recvBuffer[i * stride + SpaceDim];
+  }
+
+  if (m_verbosity > 2) {
+    pout() << m_name + "::exchangeSources -- local sources = " << numLocal << ", received sources = " << numRecv / stride
+           << endl;
+  }
+#endif
+}
+
+void
+TreePhoto::buildTree()
+{
+  CH_TIME("TreePhoto::buildTree");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::buildTree" << endl;
+  }
+
+  // TLDR: Build a kd-tree by recursively splitting the sources along the longest side of the node bounding box. The split is
+  //       at the median so the tree is balanced, and std::nth_element reorders m_sources so that each node is a contiguous range.
+  m_nodes.clear();
+
+  if (m_sources.empty()) {
+    return;
+  }
+
+  auto makeNode = [&](const int a_begin, const int a_end) -> int {
+    Node node;
+
+    node.m_begin       = a_begin;
+    node.m_end         = a_end;
+    node.m_children[0] = -1;
+    node.m_children[1] = -1;
+    node.m_lo          = m_sources[a_begin].m_position;
+    node.m_hi          = m_sources[a_begin].m_position;
+    node.m_weight      = 0.0;
+    node.m_center      = RealVect::Zero;
+
+    Real absWeight = 0.0;
+
+    for (int i = a_begin; i < a_end; i++) {
+      const Source& s = m_sources[i];
+
+      node.m_lo = min(node.m_lo, s.m_position);
+      node.m_hi = max(node.m_hi, s.m_position);
+      node.m_weight += s.m_weight;
+      node.m_center += std::abs(s.m_weight) * s.m_position;
+
+      absWeight += std::abs(s.m_weight);
+    }
+
+    node.m_center = (absWeight > 0.0) ? node.m_center / absWeight : 0.5 * (node.m_lo + node.m_hi);
+    node.m_size   = (node.m_hi - node.m_lo)[(node.m_hi - node.m_lo).maxDir(false)];
+
+    m_nodes.emplace_back(node);
+
+    return m_nodes.size() - 1;
+  };
+
+  std::vector<int> stack(1, makeNode(0, m_sources.size()));
+
+  while (!(stack.empty())) {
+    const int cur = stack.back();
+    stack.pop_back();
+
+    const int begin = m_nodes[cur].m_begin;
+    const int end   = m_nodes[cur].m_end;
+
+    if (end - begin > m_leafSize) {
+      const int dir = (m_nodes[cur].m_hi - m_nodes[cur].m_lo).maxDir(false);
+      const int mid = begin + (end - begin) / 2;
+
+      std::nth_element(m_sources.begin() + begin,
+                       m_sources.begin() + mid,
+                       m_sources.begin() + end,
+                       [dir](const Source& a, const Source& b) -> bool {
+                         return a.m_position[dir] < b.m_position[dir];
+                       });
+
+      const int left  = makeNode(begin, mid);
+      const int right = makeNode(mid, end);
+
+      m_nodes[cur].m_children[0] = left;
+      m_nodes[cur].m_children[1] = right;
+
+      stack.emplace_back(left);
+      stack.emplace_back(right);
+    }
+  }
+
+  if (m_verbosity > 2) {
+    pout() << m_name + "::buildTree -- number of sources = " << m_sources.size()
+           << ", number of nodes = " << m_nodes.size() << endl;
+  }
+}
+
+Real
+TreePhoto::evaluate(const RealVect& a_position, const Real a_kappa, const Real a_minDist) const noexcept
+{
+  // TLDR: Standard Barnes-Hut traversal. A node is accepted as a single source at its center if it is small compared to the
+  //       distance, and it is skipped entirely if even its closest point is optically far away. The tree depth is at most
+  //       log2(#sources) so a fixed-size stack is sufficient.
+  Real ret = 0.0;
+
+  if (m_nodes.empty()) {
+    return ret;
+  }
+
+  constexpr int maxStack = 128;
+
+  int stack[maxStack];
+  int numStack = 0;
+
+  stack[numStack++] = 0;
+
+  while (numStack > 0) {
+    const Node& node = m_nodes[stack[--numStack]];
+
+    // Distance to the bounding box.
+    Real minDist2 = 0.0;
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      const Real d = std::max(std::max(node.m_lo[dir] - a_position[dir], a_position[dir] - node.m_hi[dir]), 0.0);
+
+      minDist2 += d * d;
+    }
+
+    if (a_kappa * std::sqrt(minDist2) > m_maxOpticalDepth) {
+      continue;
+    }
+
+    const Real r = (a_position - node.m_center).vectorLength();
+
+    if (minDist2 > 0.0 && node.m_size < m_theta * r) {
+      ret += node.m_weight * this->kernel(a_kappa, r);
+    }
+    else if (node.m_children[0] < 0) {
+      for (int i = node.m_begin; i < node.m_end; i++) {
+        const Source& s  = m_sources[i];
+        const Real    rs = (a_position - s.m_position).vectorLength();
+
+        if (rs > a_minDist) {
+          ret += s.m_weight * this->kernel(a_kappa, rs);
+        }
+      }
+    }
+    else {
+      CH_assert(numStack + 2 <= maxStack);
+
+      stack[numStack++] = node.m_children[0];
+      stack[numStack++] = node.m_children[1];
+    }
+  }
+
+  return ret;
+}
+
+std::vector<RealVect>
+TreePhoto::getImages(const RealVect& a_position) const noexcept
+{
+  std::vector<RealVect> images;
+
+  const RealVect probLo = m_amr->getProbLo();
+  const RealVect probHi = m_amr->getProbHi();
+
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    if (m_domainBc[2 * dir] == BcType::Symmetry) {
+      RealVect image = a_position;
+      image[dir]     = 2.0 * probLo[dir] - a_position[dir];
+
+      images.emplace_back(image);
+    }
+    if (m_domainBc[2 * dir + 1] == BcType::Symmetry) {
+      RealVect image = a_position;
+      image[dir]     = 2.0 * probHi[dir] - a_position[dir];
+
+      images.emplace_back(image);
+    }
+  }
+
+  return images;
+}
+
+void
+TreePhoto::computeBoundaryFlux(EBAMRIVData& a_ebFlux, const EBAMRCellData& a_phi)
+{
+  CH_TIME("TreePhoto::computeBoundaryFlux");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeBoundaryFlux" << endl;
+  }
+
+  const IrregAmrStencil<EbCentroidInterpolationStencil>& sten =
+    m_amr->getEbCentroidInterpolationStencils(m_realm, m_phase);
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    sten.apply(*a_ebFlux[lvl], *a_phi[lvl], lvl);
+  }
+
+  m_amr->averageDown(a_ebFlux, m_realm, m_phase);
+
+  DataOps::scale(a_ebFlux, 0.5 * Units::c);
+}
+
+void
+TreePhoto::computeDomainFlux(EBAMRIFData& a_domainFlux, const EBAMRCellData& a_phi)
+{
+  CH_TIME("TreePhoto::computeDomainFlux");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeDomainFlux" << endl;
+  }
+
+  // Use the value in the cell next to the domain face.
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    const DisjointBoxLayout& dbl = m_amr->getGrids(m_realm)[lvl];
+
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const EBCellFAB& phi = (*a_phi[lvl])[dit()];
+
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        for (SideIterator sit; sit.ok(); ++sit) {
+          BaseIFFAB<Real>& flux = (*a_domainFlux[lvl])[dit()](dir, sit());
+
+          FaceIterator faceit(flux.getIVS(), flux.getEBGraph(), dir, FaceStop::AllBoundaryOnly);
+
+          auto kernel = [&](const FaceIndex& face) -> void {
+            flux(face, m_comp) = 0.5 * Units::c * phi(face.getVoF(flip(sit())), m_comp);
+          };
+
+          BoxLoops::loop(faceit, kernel);
+        }
+      }
+    }
+  }
+}
+
+void
+TreePhoto::computeFlux(EBAMRCellData& a_flux, const EBAMRCellData& a_phi)
+{
+  CH_TIME("TreePhoto::computeFlux");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeFlux" << endl;
+  }
+
+  MayDay::Error("TreePhoto::computeFlux - the radiative flux is not computed by this solver. Calling this is an error");
+}
+
+void
+TreePhoto::computeDensity(EBAMRCellData& a_isotropic, const EBAMRCellData& a_phi)
+{
+  CH_TIME("TreePhoto::computeDensity");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::computeDensity" << endl;
+  }
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    const Interval interv(m_comp, m_comp);
+
+    a_phi[lvl]->localCopyTo(interv, *a_isotropic[lvl], interv);
+  }
+}
+
+void
+TreePhoto::writePlotFile()
+{
+  CH_TIME("TreePhoto::writePlotFile");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::writePlotFile" << endl;
+  }
+
+  char file_char[1000];
+  sprintf(file_char, "%s.step%07d.%dd.hdf5", m_name.c_str(), m_timeStep, SpaceDim);
+
+  Vector<std::string> names(2);
+  names[0] = "density";
+  names[1] = "isotropic source";
+
+  EBAMRCellData output;
+  m_amr->allocate(output, m_realm, m_phase, 2);
+
+  for (int lvl = 0; lvl <= m_amr->getFinestLevel(); lvl++) {
+    m_phi[lvl]->localCopyTo(Interval(0, 0), *output[lvl], Interval(0, 0));
+    m_source[lvl]->localCopyTo(Interval(0, 0), *output[lvl], Interval(1, 1));
+  }
+
+  Vector<LevelData<EBCellFAB>*> outputPtr;
+  m_amr->alias(outputPtr, output);
+
+#ifdef CH_USE_HDF5
+  constexpr int numPlotGhost = 0;
+
+  DischargeIO::writeEBHDF5(std::string(file_char),
+                           names,
+                           m_amr->getGrids(m_realm),
+                           outputPtr,
+                           m_amr->getDomains(),
+                           m_amr->getDx(),
+                           m_amr->getRefinementRatios(),
+                           m_dt,
+                           m_time,
+                           m_amr->getProbLo(),
+                           m_amr->getFinestLevel() + 1,
+                           numPlotGhost);
+#endif
+}
+
+#ifdef CH_USE_HDF5
+void
+TreePhoto::writeCheckpointLevel(HDF5Handle& a_handle, const int a_level) const
+{
+  CH_TIME("TreePhoto::writeCheckpointLevel");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::writeCheckpointLevel" << endl;
+  }
+
+  write(a_handle, *m_phi[a_level], m_name + "_phi");
+  write(a_handle, *m_source[a_level], m_name + "_src");
+}
+#endif
+
+#ifdef CH_USE_HDF5
+void
+TreePhoto::readCheckpointLevel(HDF5Handle& a_handle, const int a_level)
+{
+  CH_TIME("TreePhoto::readCheckpointLevel");
+  if (m_verbosity > 5) {
+    pout() << m_name + "::readCheckpointLevel" << endl;
+  }
+
+  read<EBCellFAB>(a_handle, *m_phi[a_level], m_name + "_phi", m_amr->getGrids(m_realm)[a_level], Interval(0, 0), false);
+  read<EBCellFAB>(a_handle,
+                  *m_source[a_level],
+                  m_name + "_src",
+                  m_amr->getGrids(m_realm)[a_level],
+                  Interval(0, 0),
+                  false);
+}
+#endif
+
+#include <CD_NamespaceFooter.H>
@@ -0,0 +1,329 @@
+/* chombo-discharge
+ * Copyright © 2021 SINTEF Energy Research.
+ * Please refer to Copyright.txt and LICENSE in the chombo-discharge root directory.
+ */
+
+/*!
+  @file   CD_AsyncPlotWriter.cpp
+  @brief  Implementation of CD_AsyncPlotWriter.H
+  @author Robert Marskar
+*/
+
+// Std includes
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Chombo includes
+#include <CH_Timer.H>
+
+// Our includes
+#include <CD_AsyncPlotWriter.H>
+#include <CD_DischargeIO.H>
+#include <CD_NamespaceHeader.H>
+
+#ifdef CH_USE_HDF5
+AsyncPlotWriter::AsyncPlotWriter()
+{
+  CH_TIME("AsyncPlotWriter::AsyncPlotWriter");
+
+  m_isPending  = false;
+  m_writeError = 0;
+}
+
+AsyncPlotWriter::~AsyncPlotWriter()
+{
+  CH_TIME("AsyncPlotWriter::~AsyncPlotWriter");
+
+  this->finish();
+}
+
+bool
+AsyncPlotWriter::isPending() const noexcept
+{
+  return m_isPending;
+}
+
+bool
+AsyncPlotWriter::canUseHelperThread() noexcept
+{
+#ifdef CH_MPI
+  int provided = MPI_THREAD_SINGLE;
+  int isMain   = 0;
+
+  MPI_Query_thread(&provided);
+  MPI_Is_thread_main(&isMain);
+
+  return provided >= MPI_THREAD_FUNNELED && isMain != 0;
+#else
+  return true;
+#endif
+}
+
+void
+AsyncPlotWriter::writePlotFile(const std::string&                   a_filename,
+                               const Vector<std::string>&           a_variableNames,
+                               const Vector<DisjointBoxLayout>&     a_grids,
+                               const Vector<LevelData<EBCellFAB>*>& a_data,
+                               const Vector<ProblemDomain>&         a_domains,
+                               const Vector<Real>                   a_dx,
+                               const Vector<int>                    a_refinementRatios,
+                               const Real                           a_dt,
+                               const Real                           a_time,
+                               const int                            a_numLevels,
+                               const int                            a_numGhost)
+{
+  CH_TIME("AsyncPlotWriter::writePlotFile");
+
+  CH_assert(a_refinementRatios.size() >= a_numLevels - 1);
+
+  // Barrier before the next write.
+  this->finish();
+
+  // Copy the data into the staging buffers.
+  Vector<std::string> variableNamesHDF5;
+
+  DischargeIO::stageEBHDF5(m_stagedData,
+                           variableNamesHDF5,
+                           a_variableNames,
+                           a_grids,
+                           a_data,
+                           a_domains,
+                           a_dx,
+                           a_numLevels,
+                           a_numGhost);
+
+  const int     numCompTotal = variableNamesHDF5.size();
+  const IntVect ghostVect    = a_numGhost * IntVect::Unit;
+
+  // Create the file and write the header. This is collective.
+#ifdef CH_MPI
+  MPI_Barrier(Chombo_MPI::comm);
+#endif
+  m_filename = a_filename;
+
+  HDF5Handle handle(a_filename.c_str(), HDF5Handle::CREATE);
+
+  DischargeIO::getEBHDF5Header(variableNamesHDF5, a_numLevels).writeToFile(handle);
+
+  // TLDR: We write the same level structure as Chombo's writeLevel, i.e. the level metadata, the boxes, the data
+  //       attributes, the offsets for each box, and the data itself. Everything except the data is written here. For the
+  //       data we only create the dataset and compute where each box goes in the file. The data set is contiguous and
+  //       allocated when it is created, so the data for a box is at the dataset address plus the box offset. The actual
+  //       data is written by writeBlocks.
+  hid_t dataProps = H5Pcreate(H5P_DATASET_CREATE);
+
+  H5Pset_layout(dataProps, H5D_CONTIGUOUS);
+  H5Pset_alloc_time(dataProps, H5D_ALLOC_TIME_EARLY);
+  H5Pset_fill_time(dataProps, H5D_FILL_TIME_NEVER);
+
+  for (int lvl = 0; lvl < a_numLevels; lvl++) {
+    const LevelData<FArrayBox>& stagedData = *m_stagedData[lvl];
+    const DisjointBoxLayout&    dbl        = stagedData.disjointBoxLayout();
+
+    const int refRatio = (lvl != a_numLevels - 1) ? a_refinementRatios[lvl] : 1;
+
+    handle.setGroupToLevel(lvl);
+
+    const std::string levelGroup = handle.getGroup();
+
+    // Level metadata.
+    HDF5HeaderData levelHeader;
+
+    levelHeader.m_real["dx"]         = a_dx[lvl];
+    levelHeader.m_real["dt"]         = a_dt;
+    levelHeader.m_real["time"]       = a_time;
+    levelHeader.m_box["prob_domain"] = a_domains[lvl].domainBox();
+    levelHeader.m_int["ref_ratio"]   = refRatio;
+
+    levelHeader.writeToFile(handle);
+
+    // Write the boxes.
+    const int err = write(handle, dbl);
+    if (err != 0) {
+      MayDay::Error("AsyncPlotWriter::writePlotFile -- could not write boxes");
+    }
+
+    // Data attributes.
+    HDF5HeaderData dataHeader;
+
+    dataHeader.m_int["comps"]           = numCompTotal;
+    dataHeader.m_string["objectType"]   = "FArrayBox";
+    dataHeader.m_intvect["ghost"]       = ghostVect;
+    dataHeader.m_intvect["outputGhost"] = ghostVect;
+
+    handle.setGroup(levelGroup + "/data_attributes");
+    dataHeader.writeToFile(handle);
+    handle.setGroup(levelGroup);
+
+    // Compute the offsets of each box in the dataset. Every rank knows the full layout so this does not require
+    // communication.
+    std::vector<long long> offsets(1, 0LL);
+    for (LayoutIterator lit = dbl.layoutIterator(); lit.ok(); ++lit) {
+      const Box grownBox = grow(dbl[lit()], ghostVect);
+
+      offsets.emplace_back(offsets.back() + grownBox.numPts() * numCompTotal);
+    }
+
+    // Create the offset and data datasets. Dataset creation is collective, but only the master rank writes the offsets.
+    hsize_t offsetDims = offsets.size();
+    hsize_t dataDims   = offsets.back();
+
+    hid_t offsetSpace = H5Screate_simple(1, &offsetDims, nullptr);
+    hid_t dataSpace   = H5Screate_simple(1, &dataDims, nullptr);
+
+#ifdef CH_USE_DOUBLE
+    const hid_t realType = H5T_NATIVE_DOUBLE;
+#else
+    const hid_t realType = H5T_NATIVE_FLOAT;
+#endif
+
+    hid_t offsetSet = H5Dcreate2(handle.groupID(),
+                                 "data:offsets=0",
+                                 H5T_NATIVE_LLONG,
+                                 offsetSpace,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT);
+    hid_t dataSet = H5Dcreate2(handle.groupID(),
+                               "data:datatype=0",
+                               realType,
+                               dataSpace,
+                               H5P_DEFAULT,
+                               dataProps,
+                               H5P_DEFAULT);
+
+    if (offsetSet < 0 || dataSet < 0) {
+      MayDay::Error("AsyncPlotWriter::writePlotFile -- could not create datasets");
+    }
+
+    const haddr_t dataAddress = H5Dget_offset(dataSet);
+
+    if (dataDims > 0 && dataAddress == HADDR_UNDEF) {
+      MayDay::Error("AsyncPlotWriter::writePlotFile -- could not get dataset address");
+    }
+
+    if (procID() == 0) {
+      H5Dwrite(offsetSet, H5T_NATIVE_LLONG, offsetSpace, offsetSpace, H5P_DEFAULT, &offsets[0]);
+    }
+
+    H5Dclose(offsetSet);
+    H5Dclose(dataSet);
+    H5Sclose(offsetSpace);
+    H5Sclose(dataSpace);
+
+    // Each patch on this rank is one contiguous block in the dataset. The staged FArrayBoxes were allocated with exactly
+    // the output ghost cells, so the data for a patch is already contiguous in memory.
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      const FArrayBox& fab = stagedData[dit()];
+      const int        idx = dit().intCode();
+
+      CH_assert(fab.box() == grow(dbl[dit()], ghostVect));
+
+      Block block;
+
+      block.m_offset = dataAddress + offsets[idx] * sizeof(Real);
+      block.m_size   = (offsets[idx + 1] - offsets[idx]) * sizeof(Real);
+      block.m_data   = fab.dataPtr();
+
+      m_blocks.emplace_back(block);
+    }
+  }
+
+  H5Pclose(dataProps);
+
+  // Closing the file is collective. After this, the only thing left is the raw data.
+  handle.close();
+
+  m_isPending  = true;
+  m_writeError = 0;
+
+  // Write the data. If we can't use a helper thread we write it now and finish immediately.
+  if (AsyncPlotWriter::canUseHelperThread()) {
+    m_thread = std::thread(&AsyncPlotWriter::writeBlocks, this);
+  }
+  else {
+    this->writeBlocks();
+    this->finish();
+  }
+}
+
+void
+AsyncPlotWriter::writeBlocks()
+{
+  // Note: This runs on the helper thread, so no Chombo timers, pout(), MayDay, HDF5, or MPI in here. Errors are reported
+  //       by finish().
+  if (m_blocks.empty()) {
+    return;
+  }
+
+  const int fd = open(m_filename.c_str(), O_WRONLY);
+
+  if (fd < 0) {
+    m_writeError = errno;
+
+    return;
+  }
+
+  for (const auto& block : m_blocks) {
+    const char* data   = reinterpret_cast<const char*>(block.m_data);
+    size_t      remain = block.m_size;
+    off_t       offset = block.m_offset;
+
+    while (remain > 0 && m_writeError == 0) {
+      const ssize_t written = pwrite(fd, data, remain, offset);
+
+      if (written < 0) {
+        if (errno != EINTR) {
+          m_writeError = errno;
+        }
+      }
+      else {
+        data += written;
+        remain -= written;
+        offset += written;
+      }
+    }
+  }
+
+  if (close(fd) != 0 && m_writeError == 0) {
+    m_writeError = errno;
+  }
+}
+
+void
+AsyncPlotWriter::finish()
+{
+  CH_TIME("AsyncPlotWriter::finish");
+
+  if (m_isPending) {
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+
+    if (m_writeError != 0) {
+      const std::string err = "AsyncPlotWriter::finish -- could not write data to '" + m_filename +
+                              "': " + std::string(std::strerror(m_writeError));
+
+      MayDay::Error(err.c_str());
+    }
+
+    // Make sure that every rank has written its data before anyone touches the file.
+#ifdef CH_MPI
+    MPI_Barrier(Chombo_MPI::comm);
+#endif
+
+    for (int lvl = 0; lvl < m_stagedData.size(); lvl++) {
+      delete m_stagedData[lvl];
+    }
+
+    m_stagedData.resize(0);
+    m_blocks.resize(0);
+
+    m_isPending = false;
+  }
+}
+#endif
+
+#include <CD_NamespaceFooter.H>
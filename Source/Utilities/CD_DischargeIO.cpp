@@ -9,6 +9,14 @@
   @author Robert Marskar
 */
 
+// Std includes
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <vector>
+
 // Chombo includes
 #include <CH_HDF5.H>
 #include <EBAMRIO.H>
@@ -35,6 +43,83 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
 {
   CH_TIME("DischargeIO::writeEBHDF5");
 
+  CH_assert(a_refinementRatios.size() >= a_numLevels - 1);
+
+  // Set up the Chombo data and the variable names that go in the file.
+  Vector<LevelData<FArrayBox>*> chomboData;
+  Vector<std::string>           variableNamesHDF5;
+
+  DischargeIO::stageEBHDF5(chomboData,
+                           variableNamesHDF5,
+                           a_variableNames,
+                           a_grids,
+                           a_data,
+                           a_domains,
+                           a_dx,
+                           a_numLevels,
+                           a_numGhost);
+
+  const int numCompTotal = variableNamesHDF5.size();
+
+  // Now write the data to HDF5.
+#ifdef CH_MPI
+  MPI_Barrier(Chombo_MPI::comm);
+#endif
+  HDF5Handle handle(a_filename.c_str(), HDF5Handle::CREATE);
+
+  // Write the header to file.
+  DischargeIO::getEBHDF5Header(variableNamesHDF5, a_numLevels).writeToFile(handle);
+
+  // Go through each grid level and write it to file.
+  for (int lvl = 0; lvl < a_numLevels; lvl++) {
+    int refRatio = 1;
+
+    if (lvl != a_numLevels - 1) {
+      refRatio = a_refinementRatios[lvl];
+    }
+
+    const int success = writeLevel(handle,
+                                   lvl,
+                                   *chomboData[lvl],
+                                   a_dx[lvl],
+                                   a_dt,
+                                   a_time,
+                                   a_domains[lvl].domainBox(),
+                                   refRatio,
+                                   a_numGhost * IntVect::Unit,
+                                   Interval(0, numCompTotal - 1));
+
+    if (success != 0) {
+      MayDay::Error("DischargeIO::writeEBHDF5 -- error in writeLevel");
+    }
+  }
+
+#ifdef CH_MPI
+  MPI_Barrier(Chombo_MPI::comm);
+#endif
+  handle.close();
+
+  // Clean up memory.
+  for (int lvl = 0; lvl < a_numLevels; lvl++) {
+    delete chomboData[lvl];
+  }
+}
+#endif
+
+#ifdef CH_USE_HDF5
+void
+DischargeIO::stageEBHDF5(Vector<LevelData<FArrayBox>*>&       a_chomboData,
+                         Vector<std::string>&                 a_variableNamesHDF5,
+                         const Vector<std::string>&           a_variableNames,
+                         const Vector<DisjointBoxLayout>&     a_grids,
+                         const Vector<LevelData<EBCellFAB>*>& a_data,
+                         const Vector<ProblemDomain>&         a_domains,
+                         const Vector<Real>                   a_dx,
+                         const int                            a_numLevels,
+                         const int                            a_numGhost)
+{
+  CH_TIME("DischargeIO::stageEBHDF5");
+
   const int numInputVars = a_data[0]->nComp();
 
   // Basic assertions to make sure the input makes sense.
@@ -42,7 +127,6 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
   CH_assert(a_numGhost >= 0);
   CH_assert(a_grids.size() >= a_numLevels);
   CH_assert(a_data.size() >= a_numLevels);
-  CH_assert(a_refinementRatios.size() >= a_numLevels - 1);
   CH_assert(a_variableNames.size() >= numInputVars);
 
   // Indices for where we store the Chombo stuff. This is for storing the volume fraction, EB boundary area,
@@ -58,7 +142,9 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
 
   // Now create a vector of all the variable names. This is the user input variables plus the EB-related variables
   // for doing the EB reconstruction.
-  Vector<std::string> variableNamesHDF5(numCompTotal);
+  Vector<std::string>& variableNamesHDF5 = a_variableNamesHDF5;
+
+  variableNamesHDF5.resize(numCompTotal);
 
   const std::string volFracName("fraction-0");
   const std::string boundaryAreaName("boundaryArea-0");
@@ -97,7 +183,9 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
   variableNamesHDF5[indexDist] = distName;
 
   // Done with variables. Now set up some storage for Chombo data on each level.
-  Vector<LevelData<FArrayBox>*> chomboData(a_numLevels, nullptr);
+  Vector<LevelData<FArrayBox>*>& chomboData = a_chomboData;
+
+  chomboData.resize(a_numLevels, nullptr);
 
   // set things up for each level
   for (int lvl = 0; lvl < a_numLevels; lvl++) {
@@ -262,22 +350,22 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
       }
     } // End grid patch loop.
   }   // End of level loop.
-
-  // Now write the data to HDF5.
-#ifdef CH_MPI
-  MPI_Barrier(Chombo_MPI::comm);
+}
 #endif
-  HDF5Handle handle(a_filename.c_str(), HDF5Handle::CREATE);
 
-  // Write the header to file.
+#ifdef CH_USE_HDF5
+HDF5HeaderData
+DischargeIO::getEBHDF5Header(const Vector<std::string>& a_variableNamesHDF5, const int a_numLevels)
+{
+  CH_TIME("DischargeIO::getEBHDF5Header");
+
+  const int numCompTotal = a_variableNamesHDF5.size();
+
   HDF5HeaderData header;
 
   header.m_string["filetype"]    = "VanillaAMRFileType";
   header.m_int["num_levels"]     = a_numLevels;
   header.m_int["num_components"] = numCompTotal;
-#if 0 // Uncommenting this because although VisIt uses the attribute, slice operators tend to break. 
-  header.m_realvect["prob_lo"]        = a_probLo;
-#endif
 
   for (int comp = 0; comp < numCompTotal; comp++) {
     char labelString[100];
@@ -285,39 +373,482 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
 
     std::string label(labelString);
 
-    header.m_string[label] = variableNamesHDF5[comp];
+    header.m_string[label] = a_variableNamesHDF5[comp];
   }
 
-  header.writeToFile(handle);
+  return header;
+}
+#endif
+
+#ifdef CH_USE_HDF5
+void
+DischargeIO::writeEBHDF5Aggregated(const std::string&                   a_filename,
+                                   const Vector<std::string>&           a_variableNames,
+                                   const Vector<DisjointBoxLayout>&     a_grids,
+                                   const Vector<LevelData<EBCellFAB>*>& a_data,
+                                   const Vector<ProblemDomain>&         a_domains,
+                                   const Vector<Real>                   a_dx,
+                                   const Vector<int>                    a_refinementRatios,
+                                   const Real                           a_dt,
+                                   const Real                           a_time,
+                                   const int                            a_numLevels,
+                                   const int                            a_numGhost,
+                                   const AggregationParameters&         a_parameters,
+                                   const CompressionParameters&         a_compression)
+{
+  CH_TIME("DischargeIO::writeEBHDF5Aggregated");
+
+  CH_assert(a_refinementRatios.size() >= a_numLevels - 1);
+
+  // Set up the Chombo data and the variable names that go in the file.
+  Vector<LevelData<FArrayBox>*> chomboData;
+  Vector<std::string>           variableNamesHDF5;
+
+  DischargeIO::stageEBHDF5(chomboData,
+                           variableNamesHDF5,
+                           a_variableNames,
+                           a_grids,
+                           a_data,
+                           a_domains,
+                           a_dx,
+                           a_numLevels,
+                           a_numGhost);
+
+  const int     numCompTotal = variableNamesHDF5.size();
+  const IntVect ghostVect    = a_numGhost * IntVect::Unit;
+
+#ifdef CH_USE_DOUBLE
+  const hid_t realType = H5T_NATIVE_DOUBLE;
+#else
+  const hid_t realType = H5T_NATIVE_FLOAT;
+#endif
+
+  // Type of the data in the file. HDF5 converts from realType when we write.
+  const hid_t fileType = (a_compression.m_precision == Precision::Single) ? H5T_NATIVE_FLOAT : realType;
+
+  // Check that the deflate filter is available, and fall back to uncompressed output if it is not.
+  Compression compression = a_compression.m_compression;
+  if (compression != Compression::None && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+    MayDay::Warning("DischargeIO::writeEBHDF5Aggregated -- deflate filter not available, writing uncompressed data");
+
+    compression = Compression::None;
+  }
+
+  // For lossy compression we round each user variable to the nearest multiple of a power of two which is smaller than
+  // the error bound. The rounded values have few significant bits, so they deflate well. The EB variables, which
+  // come after the user variables, are left alone since VisIt needs them for the EB reconstruction.
+  if (compression == Compression::Lossy) {
+    CH_TIME("DischargeIO::writeEBHDF5Aggregated::quantize");
+
+    const int numUserComps = a_variableNames.size();
+
+    // Largest absolute value of each variable, across all levels.
+    std::vector<Real> maxAbs(numUserComps, 0.0);
+
+    for (int lvl = 0; lvl < a_numLevels; lvl++) {
+      for (DataIterator dit(chomboData[lvl]->dataIterator()); dit.ok(); ++dit) {
+        const FArrayBox& fab = (*chomboData[lvl])[dit()];
+
+        for (int comp = 0; comp < numUserComps; comp++) {
+          maxAbs[comp] = std::max(maxAbs[comp], fab.norm(0, comp, 1));
+        }
+      }
+    }
+
+#ifdef CH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, maxAbs.data(), numUserComps, MPI_CH_REAL, MPI_MAX, Chombo_MPI::comm);
+#endif
+
+    for (int comp = 0; comp < numUserComps; comp++) {
+      const Real errorBound = a_compression.m_errorBound * maxAbs[comp];
+
+      if (errorBound > 0.0 && std::isfinite(errorBound)) {
+        const Real quantum    = std::pow(2.0, std::floor(std::log2(2.0 * errorBound)));
+        const Real invQuantum = 1.0 / quantum;
+
+        for (int lvl = 0; lvl < a_numLevels; lvl++) {
+          for (DataIterator dit(chomboData[lvl]->dataIterator()); dit.ok(); ++dit) {
+            FArrayBox& fab = (*chomboData[lvl])[dit()];
+
+            Real* const     data = fab.dataPtr(comp);
+            const long long size = fab.box().numPts();
+
+            for (long long i = 0; i < size; i++) {
+              data[i] = quantum * std::round(data[i] * invQuantum);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Figure out which ranks write to the file. The aggregators are spread evenly over the ranks so that they (hopefully)
+  // end up on different nodes.
+  const int myRank         = procID();
+  const int numRanks       = numProc();
+  const int numAggregators = (a_parameters.m_numAggregators > 0) ? std::min(a_parameters.m_numAggregators, numRanks)
+                                                                 : numRanks;
+
+  const long long chunkSize = std::max(1LL, a_parameters.m_chunkSize / static_cast<long long>(sizeof(Real)));
+
+  auto aggregatorRank = [numRanks, numAggregators](const int a_aggregator) -> int {
+    return (a_aggregator * numRanks) / numAggregators;
+  };
+
+  // File access properties. We give MPI-IO the same number of aggregators and buffer size so that its collective
+  // buffering lines up with ours.
+  hid_t fileAccess = H5Pcreate(H5P_FILE_ACCESS);
+
+#ifdef CH_MPI
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "romio_cb_write", "enable");
+  MPI_Info_set(info, "cb_nodes", std::to_string(numAggregators).c_str());
+  MPI_Info_set(info, "cb_buffer_size", std::to_string(chunkSize * sizeof(Real)).c_str());
+  if (a_parameters.m_alignment > 1) {
+    MPI_Info_set(info, "striping_unit", std::to_string(a_parameters.m_alignment).c_str());
+  }
+
+  H5Pset_fapl_mpio(fileAccess, Chombo_MPI::comm, info);
+#endif
+
+  // Only objects that are larger than the alignment are aligned, which keeps the metadata compact.
+  if (a_parameters.m_alignment > 1) {
+    H5Pset_alignment(fileAccess, a_parameters.m_alignment, a_parameters.m_alignment);
+  }
+
+#ifdef CH_MPI
+  MPI_Barrier(Chombo_MPI::comm);
+#endif
+
+  const hid_t file = H5Fcreate(a_filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccess);
+
+  H5Pclose(fileAccess);
+#ifdef CH_MPI
+  MPI_Info_free(&info);
+#endif
+
+  if (file < 0) {
+    MayDay::Error("DischargeIO::writeEBHDF5Aggregated -- could not create file");
+  }
+
+  // All raw data writes are collective. Ranks that have nothing to write participate with empty selections.
+  hid_t transfer = H5Pcreate(H5P_DATASET_XFER);
+#ifdef CH_MPI
+  H5Pset_dxpl_mpio(transfer, H5FD_MPIO_COLLECTIVE);
+#endif
+
+  auto collectiveWrite =
+    [transfer](const hid_t a_dataset, const hid_t a_type, hsize_t a_offset, hsize_t a_count, const void* a_buffer) {
+      hid_t fileSpace = H5Dget_space(a_dataset);
+      hid_t memSpace;
+
+      if (a_count > 0) {
+        memSpace = H5Screate_simple(1, &a_count, nullptr);
+
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &a_offset, nullptr, &a_count, nullptr);
+      }
+      else {
+        const hsize_t one = 1;
+
+        memSpace = H5Screate_simple(1, &one, nullptr);
+
+        H5Sselect_none(memSpace);
+        H5Sselect_none(fileSpace);
+      }
+
+      // Some HDF5 versions don't like null buffers, even for empty selections.
+      static long long dummy = 0LL;
+
+      const void* buffer = (a_buffer != nullptr) ? a_buffer : &dummy;
+
+      const herr_t err = H5Dwrite(a_dataset, a_type, memSpace, fileSpace, transfer, buffer);
+
+      if (err < 0) {
+        MayDay::Error("DischargeIO::writeEBHDF5Aggregated -- could not write data");
+      }
+
+      H5Sclose(memSpace);
+      H5Sclose(fileSpace);
+    };
+
+  // Write the same global attributes and file header as HDF5Handle and writeEBHDF5 do.
+  HDF5HeaderData globalHeader;
+
+  globalHeader.m_int["SpaceDim"]  = SpaceDim;
+  globalHeader.m_real["testReal"] = 0.0;
+
+  hid_t globalGroup = H5Gcreate2(file, "Chombo_global", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  globalHeader.writeToLocation(globalGroup);
+  H5Gclose(globalGroup);
+
+  DischargeIO::getEBHDF5Header(variableNamesHDF5, a_numLevels).writeToLocation(file);
+
+  // Compound type for the boxes, using the same member names as Chombo.
+  struct BoxData
+  {
+    int m_lo[SpaceDim];
+    int m_hi[SpaceDim];
+  };
+
+  const char* loNames[3] = {"lo_i", "lo_j", "lo_k"};
+  const char* hiNames[3] = {"hi_i", "hi_j", "hi_k"};
+
+  hid_t boxType = H5Tcreate(H5T_COMPOUND, sizeof(BoxData));
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    H5Tinsert(boxType, loNames[dir], offsetof(BoxData, m_lo) + dir * sizeof(int), H5T_NATIVE_INT);
+  }
+  for (int dir = 0; dir < SpaceDim; dir++) {
+    H5Tinsert(boxType, hiNames[dir], offsetof(BoxData, m_hi) + dir * sizeof(int), H5T_NATIVE_INT);
+  }
 
-  // Go through each grid level and write it to file.
   for (int lvl = 0; lvl < a_numLevels; lvl++) {
-    int refRatio = 1;
+    const LevelData<FArrayBox>& levelData = *chomboData[lvl];
+    const DisjointBoxLayout&    dbl       = levelData.disjointBoxLayout();
 
-    if (lvl != a_numLevels - 1) {
-      refRatio = a_refinementRatios[lvl];
+    const int refRatio = (lvl != a_numLevels - 1) ? a_refinementRatios[lvl] : 1;
+
+    const std::string groupName  = "level_" + std::to_string(lvl);
+    const hid_t       levelGroup = H5Gcreate2(file, groupName.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    // Level metadata and data attributes.
+    HDF5HeaderData levelHeader;
+    HDF5HeaderData dataHeader;
+
+    levelHeader.m_real["dx"]         = a_dx[lvl];
+    levelHeader.m_real["dt"]         = a_dt;
+    levelHeader.m_real["time"]       = a_time;
+    levelHeader.m_box["prob_domain"] = a_domains[lvl].domainBox();
+    levelHeader.m_int["ref_ratio"]   = refRatio;
+
+    dataHeader.m_int["comps"]           = numCompTotal;
+    dataHeader.m_string["objectType"]   = "FArrayBox";
+    dataHeader.m_intvect["ghost"]       = ghostVect;
+    dataHeader.m_intvect["outputGhost"] = ghostVect;
+
+    levelHeader.writeToLocation(levelGroup);
+
+    const hid_t attributeGroup = H5Gcreate2(levelGroup, "data_attributes", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    dataHeader.writeToLocation(attributeGroup);
+    H5Gclose(attributeGroup);
+
+    // Every rank knows the full layout, so everyone can compute the boxes, the offsets of each box in the dataset, and
+    // which rank owns each box without communication.
+    std::vector<BoxData>   boxes;
+    std::vector<long long> offsets(1, 0LL);
+    std::vector<int>       owners;
+
+    for (LayoutIterator lit = dbl.layoutIterator(); lit.ok(); ++lit) {
+      const Box& box = dbl[lit()];
+
+      BoxData boxData;
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        boxData.m_lo[dir] = box.smallEnd(dir);
+        boxData.m_hi[dir] = box.bigEnd(dir);
+      }
+
+      boxes.emplace_back(boxData);
+      offsets.emplace_back(offsets.back() + grow(box, ghostVect).numPts() * numCompTotal);
+      owners.emplace_back(dbl.procID(lit()));
     }
 
-    const int success = writeLevel(handle,
-                                   lvl,
-                                   *chomboData[lvl],
-                                   a_dx[lvl],
-                                   a_dt,
-                                   a_time,
-                                   a_domains[lvl].domainBox(),
-                                   refRatio,
-                                   a_numGhost * IntVect::Unit,
-                                   Interval(0, numCompTotal - 1));
+    const int       numBoxes    = boxes.size();
+    const long long numElements = offsets.back();
 
-    if (success != 0) {
-      MayDay::Error("DischargeIO::writeEBHDF5 -- error in writeLevel");
+    // Assign each box to the aggregator whose range of the dataset contains the first element in the box. This is
+    // monotone in the box index, so each aggregator gets a contiguous range of the dataset.
+    std::vector<int> writers(numBoxes);
+
+    long long myBegin = -1LL;
+    long long myEnd   = -1LL;
+
+    for (int ibox = 0; ibox < numBoxes; ibox++) {
+      const long long aggregator = (numElements > 0) ? (offsets[ibox] * numAggregators) / numElements : 0LL;
+
+      writers[ibox] = aggregatorRank(std::min(numAggregators - 1, static_cast<int>(aggregator)));
+
+      if (writers[ibox] == myRank) {
+        myBegin = (myBegin < 0LL) ? offsets[ibox] : myBegin;
+        myEnd   = offsets[ibox + 1];
+      }
+    }
+
+    if (myBegin < 0LL) {
+      myBegin = 0LL;
+      myEnd   = 0LL;
+    }
+
+    const long long myCount = myEnd - myBegin;
+
+    std::vector<Real> writeBuffer(myCount);
+
+    // Patches that this rank also writes are copied straight into the write buffer. The others are packed into one
+    // buffer per aggregator, in layout order.
+    std::map<int, std::vector<Real>> sendBuffers;
+    std::map<int, std::vector<Real>> recvBuffers;
+
+    std::vector<std::pair<int, DataIndex>> localBoxes;
+    for (DataIterator dit(dbl); dit.ok(); ++dit) {
+      localBoxes.emplace_back(dit().intCode(), dit());
+    }
+    std::sort(localBoxes.begin(),
+              localBoxes.end(),
+              [](const std::pair<int, DataIndex>& a, const std::pair<int, DataIndex>& b) -> bool {
+                return a.first < b.first;
+              });
+
+    for (const auto& localBox : localBoxes) {
+      const int        ibox = localBox.first;
+      const FArrayBox& fab  = levelData[localBox.second];
+      const Real*      data = fab.dataPtr();
+      const long long  size = offsets[ibox + 1] - offsets[ibox];
+
+      CH_assert(fab.box() == grow(dbl[localBox.second], ghostVect));
+
+      if (writers[ibox] == myRank) {
+        std::copy(data, data + size, writeBuffer.begin() + (offsets[ibox] - myBegin));
+      }
+      else {
+        std::vector<Real>& sendBuffer = sendBuffers[writers[ibox]];
+
+        sendBuffer.insert(sendBuffer.end(), data, data + size);
+      }
+    }
+
+#ifdef CH_MPI
+    // Post receives for the patches that other ranks send us, and send our patches to their aggregators.
+    for (int ibox = 0; ibox < numBoxes; ibox++) {
+      if (writers[ibox] == myRank && owners[ibox] != myRank) {
+        std::vector<Real>& recvBuffer = recvBuffers[owners[ibox]];
+
+        recvBuffer.resize(recvBuffer.size() + offsets[ibox + 1] - offsets[ibox]);
+      }
     }
+
+    std::vector<MPI_Request> requests;
+
+    for (auto& recv : recvBuffers) {
+      if (recv.second.size() > static_cast<size_t>(INT_MAX)) {
+        MayDay::Error("DischargeIO::writeEBHDF5Aggregated -- message too large, increase the number of aggregators");
+      }
+
+      requests.emplace_back();
+      MPI_Irecv(recv.second.data(),
+                recv.second.size(),
+                MPI_CH_REAL,
+                recv.first,
+                lvl,
+                Chombo_MPI::comm,
+                &requests.back());
+    }
+
+    for (auto& send : sendBuffers) {
+      if (send.second.size() > static_cast<size_t>(INT_MAX)) {
+        MayDay::Error("DischargeIO::writeEBHDF5Aggregated -- message too large, increase the number of aggregators");
+      }
+
+      requests.emplace_back();
+      MPI_Isend(send.second.data(),
+                send.second.size(),
+                MPI_CH_REAL,
+                send.first,
+                lvl,
+                Chombo_MPI::comm,
+                &requests.back());
+    }
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    // Unpack the received patches. Each sender packed its patches in layout order, so we can step through them in the
+    // same order.
+    std::map<int, size_t> cursors;
+    for (int ibox = 0; ibox < numBoxes; ibox++) {
+      if (writers[ibox] == myRank && owners[ibox] != myRank) {
+        const long long size   = offsets[ibox + 1] - offsets[ibox];
+        size_t&         cursor = cursors[owners[ibox]];
+        const Real*     data   = recvBuffers[owners[ibox]].data() + cursor;
+
+        std::copy(data, data + size, writeBuffer.begin() + (offsets[ibox] - myBegin));
+
+        cursor += size;
+      }
+    }
+
+    sendBuffers.clear();
+    recvBuffers.clear();
+#endif
+
+    // Create the datasets.
+    hsize_t boxDims    = numBoxes;
+    hsize_t offsetDims = offsets.size();
+    hsize_t dataDims   = numElements;
+
+    hid_t boxSpace    = H5Screate_simple(1, &boxDims, nullptr);
+    hid_t offsetSpace = H5Screate_simple(1, &offsetDims, nullptr);
+    hid_t dataSpace   = H5Screate_simple(1, &dataDims, nullptr);
+
+    hid_t boxSet = H5Dcreate2(levelGroup, "boxes", boxType, boxSpace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t offsetSet =
+      H5Dcreate2(levelGroup, "data:offsets=0", H5T_NATIVE_LLONG, offsetSpace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    // Compressed datasets must be chunked. We use the same chunk size as for the writes.
+    hid_t dataCreate = H5Pcreate(H5P_DATASET_CREATE);
+    if (compression != Compression::None) {
+      const hsize_t chunkDims = std::max(1LL, std::min(chunkSize, numElements));
+
+      H5Pset_chunk(dataCreate, 1, &chunkDims);
+      H5Pset_shuffle(dataCreate);
+      H5Pset_deflate(dataCreate, std::max(0, std::min(9, a_compression.m_deflateLevel)));
+      H5Pset_fill_time(dataCreate, H5D_FILL_TIME_NEVER);
+    }
+
+    hid_t dataSet =
+      H5Dcreate2(levelGroup, "data:datatype=0", fileType, dataSpace, H5P_DEFAULT, dataCreate, H5P_DEFAULT);
+
+    H5Pclose(dataCreate);
+
+    if (boxSet < 0 || offsetSet < 0 || dataSet < 0) {
+      MayDay::Error("DischargeIO::writeEBHDF5Aggregated -- could not create datasets");
+    }
+
+    // The master rank writes the boxes and offsets.
+    const bool isMaster = (myRank == 0);
+
+    collectiveWrite(boxSet, boxType, 0, isMaster ? boxDims : 0, boxes.data());
+    collectiveWrite(offsetSet, H5T_NATIVE_LLONG, 0, isMaster ? offsetDims : 0, offsets.data());
+
+    // The aggregators write their range in chunks. The writes are collective, so everyone must take part in the same
+    // number of writes.
+    long long numWrites = (myCount + chunkSize - 1) / chunkSize;
+#ifdef CH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &numWrites, 1, MPI_LONG_LONG, MPI_MAX, Chombo_MPI::comm);
+#endif
+
+    for (long long iwrite = 0; iwrite < numWrites; iwrite++) {
+      const long long begin = std::min(myCount, iwrite * chunkSize);
+      const long long end   = std::min(myCount, begin + chunkSize);
+
+      collectiveWrite(dataSet, realType, myBegin + begin, end - begin, writeBuffer.data() + begin);
+    }
+
+    H5Dclose(boxSet);
+    H5Dclose(offsetSet);
+    H5Dclose(dataSet);
+
+    H5Sclose(boxSpace);
+    H5Sclose(offsetSpace);
+    H5Sclose(dataSpace);
+
+    H5Gclose(levelGroup);
   }
 
+  H5Tclose(boxType);
+  H5Pclose(transfer);
+
 #ifdef CH_MPI
   MPI_Barrier(Chombo_MPI::comm);
 #endif
-  handle.close();
+  H5Fclose(file);
 
   // Clean up memory.
   for (int lvl = 0; lvl < a_numLevels; lvl++) {
@@ -326,6 +857,340 @@ DischargeIO::writeEBHDF5(const std::string&                   a_filename,
 }
 #endif
 
+#ifdef CH_USE_HDF5
+void
+DischargeIO::writeParticleBlocks(HDF5Handle&                          a_handle,
+                                 const std::string&                   a_name,
+                                 const DisjointBoxLayout&             a_grids,
+                                 const LayoutData<std::vector<Real>>& a_particles,
+                                 const int                            a_numFields)
+{
+  CH_TIME("DischargeIO::writeParticleBlocks");
+
+  CH_assert(a_numFields >= SpaceDim);
+
+#ifdef CH_USE_DOUBLE
+  const hid_t realType = H5T_NATIVE_DOUBLE;
+#else
+  const hid_t realType = H5T_NATIVE_FLOAT;
+#endif
+
+  constexpr int recordSize = 2 * SpaceDim + 4;
+
+  const int myRank   = procID();
+  const int numRanks = numProc();
+  const int numBoxes = a_grids.size();
+
+  // Get the number of particles in each box. Every rank needs this in order to compute the file offsets.
+  std::vector<long long> localCounts(numBoxes, 0LL);
+  std::vector<long long> counts(numBoxes, 0LL);
+
+  for (DataIterator dit(a_grids); dit.ok(); ++dit) {
+    CH_assert(a_particles[dit()].size() % a_numFields == 0);
+
+    localCounts[dit().intCode()] = a_particles[dit()].size() / a_numFields;
+  }
+
+#ifdef CH_MPI
+  MPI_Allreduce(&localCounts[0], &counts[0], numBoxes, MPI_LONG_LONG, MPI_SUM, Chombo_MPI::comm);
+#else
+  counts = localCounts;
+#endif
+
+  // The particles are stored rank by rank, so compute where each rank's block starts.
+  std::vector<long long> rankOffsets(numRanks + 1, 0LL);
+
+  for (LayoutIterator lit = a_grids.layoutIterator(); lit.ok(); ++lit) {
+    rankOffsets[a_grids.procID(lit()) + 1] += counts[lit().intCode()];
+  }
+  for (int rank = 0; rank < numRanks; rank++) {
+    rankOffsets[rank + 1] += rankOffsets[rank];
+  }
+
+  // Build the index. Within each block the boxes are stored in layout order.
+  std::vector<long long> index(numBoxes * recordSize);
+  std::vector<long long> nextParticle(rankOffsets.begin(), rankOffsets.end() - 1);
+
+  for (LayoutIterator lit = a_grids.layoutIterator(); lit.ok(); ++lit) {
+    const int  idx  = lit().intCode();
+    const int  rank = a_grids.procID(lit());
+    const Box& box  = a_grids[lit()];
+
+    long long* record = &index[idx * recordSize];
+
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      record[dir]            = box.smallEnd(dir);
+      record[SpaceDim + dir] = box.bigEnd(dir);
+    }
+
+    record[2 * SpaceDim]     = counts[idx];
+    record[2 * SpaceDim + 1] = nextParticle[rank];
+    record[2 * SpaceDim + 2] = rankOffsets[rank];
+    record[2 * SpaceDim + 3] = rankOffsets[rank + 1] - rankOffsets[rank];
+
+    nextParticle[rank] += counts[idx];
+  }
+
+  // Pack this rank's particles into a structure-of-arrays block.
+  const long long myFirst = rankOffsets[myRank];
+  const long long myCount = rankOffsets[myRank + 1] - rankOffsets[myRank];
+
+  std::vector<Real> block(a_numFields * myCount);
+
+  for (DataIterator dit(a_grids); dit.ok(); ++dit) {
+    const int                idx       = dit().intCode();
+    const long long          first     = index[idx * recordSize + 2 * SpaceDim + 1] - myFirst;
+    const long long          num       = counts[idx];
+    const std::vector<Real>& particles = a_particles[dit()];
+
+    for (long long i = 0; i < num; i++) {
+      for (int field = 0; field < a_numFields; field++) {
+        block[field * myCount + first + i] = particles[i * a_numFields + field];
+      }
+    }
+  }
+
+  // Create the datasets. This is collective.
+  const hsize_t indexDims[2] = {(hsize_t)numBoxes, (hsize_t)recordSize};
+  const hsize_t blockDims    = a_numFields * rankOffsets[numRanks];
+
+  hid_t indexSpace = H5Screate_simple(2, indexDims, nullptr);
+  hid_t blockSpace = H5Screate_simple(1, &blockDims, nullptr);
+
+  hid_t indexSet = H5Dcreate2(a_handle.groupID(),
+                              (a_name + ":index").c_str(),
+                              H5T_NATIVE_LLONG,
+                              indexSpace,
+                              H5P_DEFAULT,
+                              H5P_DEFAULT,
+                              H5P_DEFAULT);
+  hid_t blockSet = H5Dcreate2(a_handle.groupID(),
+                              (a_name + ":blocks").c_str(),
+                              realType,
+                              blockSpace,
+                              H5P_DEFAULT,
+                              H5P_DEFAULT,
+                              H5P_DEFAULT);
+
+  if (indexSet < 0 || blockSet < 0) {
+    MayDay::Error("DischargeIO::writeParticleBlocks -- could not create datasets");
+  }
+
+  // Only the master rank writes the index.
+  if (myRank == 0 && numBoxes > 0) {
+    H5Dwrite(indexSet, H5T_NATIVE_LLONG, indexSpace, indexSpace, H5P_DEFAULT, &index[0]);
+  }
+
+  // Every rank writes its block in one collective write. Ranks without particles participate with empty selections.
+  hid_t transfer = H5Pcreate(H5P_DATASET_XFER);
+#ifdef CH_MPI
+  H5Pset_dxpl_mpio(transfer, H5FD_MPIO_COLLECTIVE);
+#endif
+
+  hsize_t offset = a_numFields * myFirst;
+  hsize_t count  = a_numFields * myCount;
+  hid_t   memSpace;
+
+  static Real dummy = 0.0;
+
+  if (count > 0) {
+    memSpace = H5Screate_simple(1, &count, nullptr);
+
+    H5Sselect_hyperslab(blockSpace, H5S_SELECT_SET, &offset, nullptr, &count, nullptr);
+  }
+  else {
+    const hsize_t one = 1;
+
+    memSpace = H5Screate_simple(1, &one, nullptr);
+
+    H5Sselect_none(memSpace);
+    H5Sselect_none(blockSpace);
+  }
+
+  const herr_t err = H5Dwrite(blockSet, realType, memSpace, blockSpace, transfer, (count > 0) ? &block[0] : &dummy);
+
+  if (err < 0) {
+    MayDay::Error("DischargeIO::writeParticleBlocks -- could not write particles");
+  }
+
+  H5Sclose(memSpace);
+  H5Pclose(transfer);
+  H5Dclose(blockSet);
+  H5Dclose(indexSet);
+  H5Sclose(blockSpace);
+  H5Sclose(indexSpace);
+}
+#endif
+
+#ifdef CH_USE_HDF5
+void
+DischargeIO::readParticleBlocks(HDF5Handle&                    a_handle,
+                                const std::string&             a_name,
+                                const DisjointBoxLayout&       a_grids,
+                                const RealVect&                a_probLo,
+                                const Real                     a_dx,
+                                LayoutData<std::vector<Real>>& a_particles,
+                                const int                      a_numFields)
+{
+  CH_TIME("DischargeIO::readParticleBlocks");
+
+  CH_assert(a_numFields >= SpaceDim);
+
+#ifdef CH_USE_DOUBLE
+  const hid_t realType = H5T_NATIVE_DOUBLE;
+#else
+  const hid_t realType = H5T_NATIVE_FLOAT;
+#endif
+
+  constexpr int recordSize = 2 * SpaceDim + 4;
+
+  hid_t indexSet = H5Dopen2(a_handle.groupID(), (a_name + ":index").c_str(), H5P_DEFAULT);
+  hid_t blockSet = H5Dopen2(a_handle.groupID(), (a_name + ":blocks").c_str(), H5P_DEFAULT);
+
+  if (indexSet < 0 || blockSet < 0) {
+    MayDay::Error(("DischargeIO::readParticleBlocks -- could not find particle blocks for '" + a_name + "'").c_str());
+  }
+
+  // Every rank reads the full index.
+  hid_t   indexSpace = H5Dget_space(indexSet);
+  hsize_t indexDims[2];
+
+  H5Sget_simple_extent_dims(indexSpace, indexDims, nullptr);
+
+  if (indexDims[1] != recordSize) {
+    MayDay::Error("DischargeIO::readParticleBlocks -- index has wrong record size");
+  }
+
+  const int numFileBoxes = indexDims[0];
+
+  std::vector<long long> index(numFileBoxes * recordSize);
+  if (numFileBoxes > 0) {
+    H5Dread(indexSet, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, &index[0]);
+  }
+
+  H5Sclose(indexSpace);
+  H5Dclose(indexSet);
+
+  // Check that the number of fields matches what is in the file.
+  hid_t   blockSpace = H5Dget_space(blockSet);
+  hsize_t blockDims;
+
+  H5Sget_simple_extent_dims(blockSpace, &blockDims, nullptr);
+
+  long long numParticles = 0LL;
+  for (int ibox = 0; ibox < numFileBoxes; ibox++) {
+    numParticles += index[ibox * recordSize + 2 * SpaceDim];
+  }
+
+  if (blockDims != a_numFields * numParticles) {
+    MayDay::Error("DischargeIO::readParticleBlocks -- number of particle fields does not match the file");
+  }
+
+  // Bounding box of the boxes on this rank. Used for quickly skipping boxes in the file.
+  Box myBoundingBox;
+  for (DataIterator dit(a_grids); dit.ok(); ++dit) {
+    a_particles[dit()].resize(0);
+
+    if (myBoundingBox.isEmpty()) {
+      myBoundingBox = a_grids[dit()];
+    }
+    else {
+      myBoundingBox.minBox(a_grids[dit()]);
+    }
+  }
+
+  std::vector<DataIndex> overlaps;
+  std::vector<Real>      buffer;
+
+  for (int ibox = 0; ibox < numFileBoxes; ibox++) {
+    const long long* record = &index[ibox * recordSize];
+
+    const long long count       = record[2 * SpaceDim];
+    const long long first       = record[2 * SpaceDim + 1];
+    const long long blockFirst  = record[2 * SpaceDim + 2];
+    const long long blockLength = record[2 * SpaceDim + 3];
+
+    if (count <= 0LL) {
+      continue;
+    }
+
+    IntVect lo;
+    IntVect hi;
+    for (int dir = 0; dir < SpaceDim; dir++) {
+      lo[dir] = record[dir];
+      hi[dir] = record[SpaceDim + dir];
+    }
+
+    const Box fileBox(lo, hi);
+
+    if (myBoundingBox.isEmpty() || !myBoundingBox.intersectsNotEmpty(fileBox)) {
+      continue;
+    }
+
+    // Find the boxes on this rank that overlap with the box in the file.
+    overlaps.resize(0);
+    for (DataIterator dit(a_grids); dit.ok(); ++dit) {
+      if (a_grids[dit()].intersectsNotEmpty(fileBox)) {
+        overlaps.emplace_back(dit());
+      }
+    }
+
+    if (overlaps.size() == 0) {
+      continue;
+    }
+
+    // The particles in the box are stored field by field in the block that holds them, so we can read all the fields with a
+    // single strided selection.
+    hsize_t start  = a_numFields * blockFirst + (first - blockFirst);
+    hsize_t stride = blockLength;
+    hsize_t blocks = a_numFields;
+    hsize_t length = count;
+    hsize_t size   = a_numFields * count;
+
+    buffer.resize(size);
+
+    hid_t memSpace = H5Screate_simple(1, &size, nullptr);
+
+    H5Sselect_hyperslab(blockSpace, H5S_SELECT_SET, &start, &stride, &blocks, &length);
+
+    const herr_t err = H5Dread(blockSet, realType, memSpace, blockSpace, H5P_DEFAULT, &buffer[0]);
+
+    if (err < 0) {
+      MayDay::Error("DischargeIO::readParticleBlocks -- could not read particles");
+    }
+
+    H5Sclose(memSpace);
+
+    // Put each particle in the box that contains it. The particle was inside fileBox when it was written, so we clamp the
+    // cell index to that box in order to avoid losing particles due to roundoff.
+    for (long long i = 0; i < count; i++) {
+      IntVect iv;
+      for (int dir = 0; dir < SpaceDim; dir++) {
+        const Real x = buffer[dir * count + i];
+
+        iv[dir] = (int)std::floor((x - a_probLo[dir]) / a_dx);
+        iv[dir] = std::max(lo[dir], std::min(hi[dir], iv[dir]));
+      }
+
+      for (const auto& din : overlaps) {
+        if (a_grids[din].contains(iv)) {
+          std::vector<Real>& particles = a_particles[din];
+
+          for (int field = 0; field < a_numFields; field++) {
+            particles.emplace_back(buffer[field * count + i]);
+          }
+
+          break;
+        }
+      }
+    }
+  }
+
+  H5Sclose(blockSpace);
+  H5Dclose(blockSet);
+}
+#endif
+
 #ifdef CH_USE_HDF5
 void
 DischargeIO::writeEBHDF5(const EBAMRCellData& a_data, const std::string& a_file)
@@ -9,6 +9,10 @@
   @author Robert Marskar
 */
 
+// Std includes
+#include <map>
+#include <algorithm>
+
 // Chombo includes
 #include <EBLevelDataOps.H>
 #include <memtrack.H>
@@ -19,6 +23,111 @@
 #include <CD_MemoryReport.H>
 #include <CD_NamespaceHeader.H>
 
+namespace MemoryReport {
+
+  /*!
+    @brief State of an open memory scope
+  */
+  struct ScopeState
+  {
+    /*!
+      @brief Memory attributed by inner scopes (or through setMemory/addMemory) while this scope was open
+    */
+    long long m_inner;
+
+    /*!
+      @brief Largest current memory that was seen while this scope was open
+    */
+    long long m_maxMemory;
+  };
+
+  /*!
+    @brief Memory ledger for the per-category accounting. 
+  */
+  struct Ledger
+  {
+    /*!
+      @brief Memory per owner, for each category
+    */
+    std::map<Category, std::map<const void*, long long>> m_owners;
+
+    /*!
+      @brief High-water mark per owner, for each category
+    */
+    std::map<Category, std::map<const void*, long long>> m_ownerHighWater;
+
+    /*!
+      @brief Current memory in each category
+    */
+    std::map<Category, long long> m_current;
+
+    /*!
+      @brief High-water mark for each category
+    */
+    std::map<Category, long long> m_highWater;
+
+    /*!
+      @brief Currently open scopes, innermost scope last.
+    */
+    std::vector<ScopeState> m_scopes;
+  };
+
+  /*!
+    @brief Get the ledger.
+  */
+  static Ledger&
+  getLedger()
+  {
+    static Ledger ledger;
+
+    return ledger;
+  }
+
+  /*!
+    @brief Update the largest memory seen by all open scopes.
+    @param[in] a_current Current memory
+  */
+  static void
+  sampleScopes(const long long a_current)
+  {
+    for (auto& scope : getLedger().m_scopes) {
+      scope.m_maxMemory = std::max(scope.m_maxMemory, a_current);
+    }
+  }
+
+  /*!
+    @brief Set the memory held by an owner, and update the category total and the high-water marks.
+    @param[in] a_category Memory category
+    @param[in] a_owner    Owner
+    @param[in] a_bytes    New memory held by the owner
+    @param[in] a_peak     Largest memory that the owner held on the way to a_bytes (e.g. transient memory in a scope).
+    @return Returns the change in the memory held by the owner.
+  */
+  static long long
+  updateOwner(const Category a_category, const void* const a_owner, const long long a_bytes, const long long a_peak)
+  {
+    Ledger& ledger = getLedger();
+
+    long long& owned          = ledger.m_owners[a_category][a_owner];
+    long long& ownerHighWater = ledger.m_ownerHighWater[a_category][a_owner];
+
+    const long long newBytes  = std::max(0LL, a_bytes);
+    const long long peakBytes = std::max(newBytes, a_peak);
+    const long long delta     = newBytes - owned;
+
+    long long& current   = ledger.m_current[a_category];
+    long long& highWater = ledger.m_highWater[a_category];
+
+    ownerHighWater = std::max(ownerHighWater, peakBytes);
+    highWater      = std::max(highWater, current + peakBytes - owned);
+
+    owned = newBytes;
+    current += delta;
+
+    return delta;
+  }
+} // namespace MemoryReport
+
 void
 MemoryReport::getMaxMinMemoryUsage()
 {
@@ -116,4 +225,221 @@ MemoryReport::getMemoryUsage(Vector<Real>& a_peak, Vector<Real>& a_unfreed)
 #endif
 }
 
+std::string
+MemoryReport::getCategoryName(const Category a_category)
+{
+  std::string ret;
+
+  switch (a_category) {
+  case Category::EBIS: {
+    ret = "EBIS";
+
+    break;
+  }
+  case Category::Realm: {
+    ret = "Realm";
+
+    break;
+  }
+  case Category::Operators: {
+    ret = "Operators";
+
+    break;
+  }
+  case Category::Multigrid: {
+    ret = "Multigrid";
+
+    break;
+  }
+  case Category::Particles: {
+    ret = "Particles";
+
+    break;
+  }
+  case Category::Solvers: {
+    ret = "Solvers";
+
+    break;
+  }
+  default: {
+    MayDay::Error("MemoryReport::getCategoryName -- logic bust");
+
+    break;
+  }
+  }
+
+  return ret;
+}
+
+long long
+MemoryReport::getCurrentMemory()
+{
+  long long curMemLL;
+  long long peakMemLL;
+  overallMemoryUsage(curMemLL, peakMemLL);
+
+  return curMemLL;
+}
+
+void
+MemoryReport::setMemory(const Category a_category, const void* const a_owner, const long long a_bytes)
+{
+  CH_TIME("MemoryReport::setMemory");
+
+  Ledger& ledger = getLedger();
+
+  const long long delta = updateOwner(a_category, a_owner, a_bytes, a_bytes);
+
+  // Enclosing scope should not count this memory again.
+  if (!(ledger.m_scopes.empty())) {
+    sampleScopes(MemoryReport::getCurrentMemory());
+
+    ledger.m_scopes.back().m_inner += delta;
+  }
+}
+
+void
+MemoryReport::addMemory(const Category a_category, const void* const a_owner, const long long a_bytes)
+{
+  CH_TIME("MemoryReport::addMemory");
+
+  const long long owned = getLedger().m_owners[a_category][a_owner];
+
+  MemoryReport::setMemory(a_category, a_owner, owned + a_bytes);
+}
+
+void
+MemoryReport::releaseMemory(const void* const a_owner)
+{
+  CH_TIME("MemoryReport::releaseMemory");
+
+  Ledger& ledger = getLedger();
+
+  for (auto& category : ledger.m_owners) {
+    auto it = category.second.find(a_owner);
+
+    if (it != category.second.end()) {
+      ledger.m_current[category.first] -= it->second;
+
+      category.second.erase(it);
+    }
+  }
+
+  // The address may be reused by a new owner.
+  for (auto& category : ledger.m_ownerHighWater) {
+    category.second.erase(a_owner);
+  }
+}
+
+void
+MemoryReport::getCategoryMemory(const Category a_category, long long& a_current, long long& a_highWater)
+{
+  CH_TIME("MemoryReport::getCategoryMemory");
+
+  Ledger& ledger = getLedger();
+
+  a_current   = ledger.m_current[a_category];
+  a_highWater = ledger.m_highWater[a_category];
+}
+
+void
+MemoryReport::getOwnerMemory(const Category    a_category,
+                             const void* const a_owner,
+                             long long&        a_current,
+                             long long&        a_highWater)
+{
+  CH_TIME("MemoryReport::getOwnerMemory");
+
+  Ledger& ledger = getLedger();
+
+  const auto& owners     = ledger.m_owners[a_category];
+  const auto& highWaters = ledger.m_ownerHighWater[a_category];
+
+  const auto it   = owners.find(a_owner);
+  const auto itHW = highWaters.find(a_owner);
+
+  a_current   = (it != owners.end()) ? it->second : 0LL;
+  a_highWater = (itHW != highWaters.end()) ? itHW->second : 0LL;
+}
+
+void
+MemoryReport::getCategoryMemoryUsage(const Category a_category, Vector<Real>& a_current, Vector<Real>& a_highWater)
+{
+  CH_TIME("MemoryReport::getCategoryMemoryUsage");
+
+  constexpr Real BytesPerMB = 1024.0 * 1024.0;
+
+  long long current;
+  long long highWater;
+
+  MemoryReport::getCategoryMemory(a_category, current, highWater);
+
+  a_current.resize(numProc());
+  a_highWater.resize(numProc());
+
+#ifdef CH_MPI
+  std::vector<long long> allCurrent(numProc());
+  std::vector<long long> allHighWater(numProc());
+
+  MPI_Allgather(&current, 1, MPI_LONG_LONG, &allCurrent[0], 1, MPI_LONG_LONG, Chombo_MPI::comm);
+  MPI_Allgather(&highWater, 1, MPI_LONG_LONG, &allHighWater[0], 1, MPI_LONG_LONG, Chombo_MPI::comm);
+
+  for (int i = 0; i < numProc(); i++) {
+    a_current[i]   = allCurrent[i] / BytesPerMB;
+    a_highWater[i] = allHighWater[i] / BytesPerMB;
+  }
+#else
+  a_current[0]   = current / BytesPerMB;
+  a_highWater[0] = highWater / BytesPerMB;
+#endif
+}
+
+MemoryReport::MemoryScope::MemoryScope(const Category a_category, const void* const a_owner)
+{
+  m_category = a_category;
+  m_owner    = a_owner;
+
+  overallMemoryUsage(m_startMemory, m_startPeak);
+
+  sampleScopes(m_startMemory);
+
+  getLedger().m_scopes.emplace_back(ScopeState{0LL, m_startMemory});
+}
+
+MemoryReport::MemoryScope::~MemoryScope()
+{
+  Ledger& ledger = getLedger();
+
+  long long currentMemory;
+  long long peakMemory;
+  overallMemoryUsage(currentMemory, peakMemory);
+
+  sampleScopes(currentMemory);
+
+  const ScopeState scope = ledger.m_scopes.back();
+
+  ledger.m_scopes.pop_back();
+
+  // TLDR: We only sample the memory when scopes open and close, so transient allocations inside this scope could be missed.
+  //       But if the global peak increased while the scope was open, that peak happened inside this scope. The transient
+  //       memory is attributed to this owner, including any transient memory in the inner scopes.
+  long long maxMemory = scope.m_maxMemory;
+  if (peakMemory > m_startPeak) {
+    maxMemory = std::max(maxMemory, peakMemory);
+  }
+
+  const long long delta     = currentMemory - m_startMemory;
+  const long long exclusive = delta - scope.m_inner;
+  const long long transient = maxMemory - m_startMemory;
+
+  const long long owned = ledger.m_owners[m_category][m_owner];
+
+  updateOwner(m_category, m_owner, owned + exclusive, owned + std::max(exclusive, transient));
+
+  // Everything that happened in this scope is accounted for, so the enclosing scope should skip all of it.
+  if (!(ledger.m_scopes.empty())) {
+    ledger.m_scopes.back().m_inner += delta;
+  }
+}
+
 #include <CD_NamespaceFooter.H>